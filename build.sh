@@ -6,7 +6,11 @@ echo "${SRC_FILES[@]}"
 
 CC_BIN="${CC:-gcc}"
 CFLAGS="-ffunction-sections -fdata-sections -D_POSIX_C_SOURCE=199506L -pedantic -std=c99 -g3 -O3 -Wall -Wextra -Wformat-security"
-LDFLAGS="-lm"
+LDFLAGS="-lm -pthread"
+#LEAN=1 builds without the debug names of concepts, events and implications (see src/Globals.h)
+if [[ "${LEAN:-0}" == "1" ]]; then
+    CFLAGS="$CFLAGS -DMSC_LEAN"
+fi
 GC_FLAGS="-Wl,--gc-sections -Wl,--print-gc-sections"
 
 if [[ "$(uname -s)" == "Darwin" ]]; then
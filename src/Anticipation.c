@@ -0,0 +1,208 @@
+#include "Anticipation.h"
+
+#define WHEEL_MASK (ANTICIPATION_WHEEL_SLOTS - 1)
+#define OVERFLOW_SLOT (ANTICIPATION_WHEEL_SIZE - 1)
+#define at(i) (wheel->pool[(i)-1])
+
+void Anticipation_RESET(AnticipationWheel *wheel, long currentTime)
+{
+    for(int i=0; i<ANTICIPATIONS_MAX; i++)
+    {
+        wheel->pool[i] = (Anticipation) { .next = i+1 < ANTICIPATIONS_MAX ? i+2 : 0 };
+    }
+    wheel->free = 1;
+    for(int i=0; i<ANTICIPATION_WHEEL_SIZE; i++)
+    {
+        wheel->slots[i] = 0;
+    }
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        wheel->conceptHeads[i] = 0;
+        wheel->conceptGenerations[i] = 0;
+    }
+    wheel->now = currentTime;
+    wheel->amount = 0;
+}
+
+//the level is chosen by how far ahead the anticipation is due
+static int Anticipation_SlotOf(AnticipationWheel *wheel, long due)
+{
+    due = MAX(due, wheel->now);
+    if(due - wheel->now < ANTICIPATION_WHEEL_SLOTS)
+    {
+        return due & WHEEL_MASK;
+    }
+    if((due >> ANTICIPATION_WHEEL_BITS) - (wheel->now >> ANTICIPATION_WHEEL_BITS) < ANTICIPATION_WHEEL_SLOTS)
+    {
+        return ANTICIPATION_WHEEL_SLOTS + ((due >> ANTICIPATION_WHEEL_BITS) & WHEEL_MASK);
+    }
+    return OVERFLOW_SLOT;
+}
+
+static void Anticipation_Link(AnticipationWheel *wheel, int i)
+{
+    int slot = Anticipation_SlotOf(wheel, at(i).due);
+    at(i).slot = slot;
+    at(i).prev = 0;
+    at(i).next = wheel->slots[slot];
+    if(at(i).next != 0)
+    {
+        at(at(i).next).prev = i;
+    }
+    wheel->slots[slot] = i;
+}
+
+static void Anticipation_Unlink(AnticipationWheel *wheel, int i)
+{
+    if(at(i).prev != 0)
+    {
+        at(at(i).prev).next = at(i).next;
+    }
+    else
+    {
+        wheel->slots[at(i).slot] = at(i).next;
+    }
+    if(at(i).next != 0)
+    {
+        at(at(i).next).prev = at(i).prev;
+    }
+}
+
+//the list of the concept's anticipations, dropping the one of a previous concept in the same slot
+static int *Anticipation_ConceptHead(AnticipationWheel *wheel, Concept *c)
+{
+    int k = Memory_ConceptSlot(c);
+    if(wheel->conceptGenerations[k] != c->generation)
+    {
+        wheel->conceptGenerations[k] = c->generation;
+        wheel->conceptHeads[k] = 0;
+    }
+    return &wheel->conceptHeads[k];
+}
+
+static void Anticipation_ConceptUnlink(AnticipationWheel *wheel, int i)
+{
+    if(at(i).conceptPrev != 0)
+    {
+        at(at(i).conceptPrev).conceptNext = at(i).conceptNext;
+    }
+    else
+    {
+        //the head is only touched if the list still belongs to the concept
+        int k = Memory_ConceptSlot(at(i).postcondition);
+        if(wheel->conceptGenerations[k] == at(i).generation)
+        {
+            wheel->conceptHeads[k] = at(i).conceptNext;
+        }
+    }
+    if(at(i).conceptNext != 0)
+    {
+        at(at(i).conceptNext).conceptPrev = at(i).conceptPrev;
+    }
+}
+
+static void Anticipation_Free(AnticipationWheel *wheel, int i)
+{
+    at(i).next = wheel->free;
+    wheel->free = i;
+    wheel->amount--;
+}
+
+bool Anticipation_Schedule(AnticipationWheel *wheel, Concept *postcondition, int operationID, Term precondition, Truth truth, long due)
+{
+    int *head = Anticipation_ConceptHead(wheel, postcondition);
+    for(int i=*head; i!=0; i=at(i).conceptNext)
+    {
+        if(at(i).operationID == operationID && Term_Equal(&at(i).precondition, &precondition))
+        {
+            return true;
+        }
+    }
+    if(wheel->free == 0)
+    {
+        return false;
+    }
+    int i = wheel->free;
+    wheel->free = at(i).next;
+    at(i) = (Anticipation) { .postcondition = postcondition,
+                             .generation = postcondition->generation,
+                             .operationID = operationID,
+                             .precondition = precondition,
+                             .truth = truth,
+                             .due = due,
+                             .conceptNext = *head };
+    if(*head != 0)
+    {
+        at(*head).conceptPrev = i;
+    }
+    *head = i;
+    Anticipation_Link(wheel, i);
+    wheel->amount++;
+    return true;
+}
+
+int Anticipation_Confirm(AnticipationWheel *wheel, Concept *postcondition)
+{
+    int confirmed = 0;
+    int *head = Anticipation_ConceptHead(wheel, postcondition);
+    while(*head != 0)
+    {
+        int i = *head;
+        *head = at(i).conceptNext;
+        Anticipation_Unlink(wheel, i);
+        Anticipation_Free(wheel, i);
+        confirmed++;
+    }
+    return confirmed;
+}
+
+static void Anticipation_Relink(AnticipationWheel *wheel, int slot)
+{
+    int i = wheel->slots[slot];
+    wheel->slots[slot] = 0;
+    while(i != 0)
+    {
+        int next = at(i).next;
+        Anticipation_Link(wheel, i);
+        i = next;
+    }
+}
+
+//at the start of each level 1 step, its anticipations move to level 0, and after a full turn of level 1 the overflow is redistributed
+static void Anticipation_Cascade(AnticipationWheel *wheel)
+{
+    long step = wheel->now >> ANTICIPATION_WHEEL_BITS;
+    if((step & WHEEL_MASK) == 0)
+    {
+        Anticipation_Relink(wheel, OVERFLOW_SLOT);
+    }
+    Anticipation_Relink(wheel, ANTICIPATION_WHEEL_SLOTS + (step & WHEEL_MASK));
+}
+
+bool Anticipation_PopExpired(AnticipationWheel *wheel, long currentTime, Anticipation *expired)
+{
+    while(wheel->now < currentTime)
+    {
+        //the level 0 slot of the current cycle only holds anticipations due now
+        int i = wheel->slots[wheel->now & WHEEL_MASK];
+        if(i != 0)
+        {
+            Anticipation_Unlink(wheel, i);
+            Anticipation_ConceptUnlink(wheel, i);
+            *expired = at(i);
+            Anticipation_Free(wheel, i);
+            return true;
+        }
+        if(wheel->amount == 0)
+        {
+            wheel->now = currentTime;
+            break;
+        }
+        wheel->now++;
+        if((wheel->now & WHEEL_MASK) == 0)
+        {
+            Anticipation_Cascade(wheel);
+        }
+    }
+    return false;
+}
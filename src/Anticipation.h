@@ -0,0 +1,67 @@
+#ifndef H_ANTICIPATION
+#define H_ANTICIPATION
+
+////////////////////////////
+//  Anticipation wheel    //
+////////////////////////////
+//Predicted consequences waiting for confirmation, kept in a hierarchical
+//timing wheel keyed by the time they are due. Scheduling, confirmation
+//and expiry are O(1) per anticipation (amortized for the cascades).
+
+//References//
+//-----------//
+#include "Memory.h"
+
+//Parameters//
+//----------//
+#define ANTICIPATIONS_MAX 1024
+#define ANTICIPATION_WHEEL_BITS 6
+#define ANTICIPATION_WHEEL_SLOTS (1 << ANTICIPATION_WHEEL_BITS)
+//level 0 holds the next ANTICIPATION_WHEEL_SLOTS cycles, level 1 the next ANTICIPATION_WHEEL_SLOTS^2 in steps of
+//ANTICIPATION_WHEEL_SLOTS, and a last slot the anticipations due even later
+#define ANTICIPATION_WHEEL_SIZE (2 * ANTICIPATION_WHEEL_SLOTS + 1)
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    //the anticipated event's concept and the implication predicting it
+    Concept *postcondition;
+    long generation;
+    int operationID;
+    Term precondition;
+    //negative evidence to add if the anticipation expires
+    Truth truth;
+    long due;
+    //links as index+1, 0 for none: within the wheel slot and among the anticipations of the postcondition
+    int slot;
+    int prev, next;
+    int conceptPrev, conceptNext;
+} Anticipation;
+typedef struct
+{
+    Anticipation pool[ANTICIPATIONS_MAX];
+    //first free entry, chained via next
+    int free;
+    int slots[ANTICIPATION_WHEEL_SIZE];
+    //per concept slot, valid while the concept has the recorded generation
+    int conceptHeads[CONCEPTS_MAX];
+    long conceptGenerations[CONCEPTS_MAX];
+    //the next cycle to expire
+    long now;
+    int amount;
+} AnticipationWheel;
+
+//Methods//
+//-------//
+//Remove all anticipations, the first cycle to expire being currentTime
+void Anticipation_RESET(AnticipationWheel *wheel, long currentTime);
+//Anticipate the postcondition of <(&/,precondition,op) =/> postcondition> until due (inclusive),
+//false if the wheel is full. An equal pending anticipation is kept instead of adding another.
+bool Anticipation_Schedule(AnticipationWheel *wheel, Concept *postcondition, int operationID, Term precondition, Truth truth, long due);
+//The postcondition happened: cancel its pending anticipations, returning how many
+int Anticipation_Confirm(AnticipationWheel *wheel, Concept *postcondition);
+//Take an anticipation which was due before currentTime, false if there is none
+bool Anticipation_PopExpired(AnticipationWheel *wheel, long currentTime, Anticipation *expired);
+
+#endif
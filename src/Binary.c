@@ -0,0 +1,21 @@
+#include "Binary.h"
+
+bool Binary_Transfer(FILE *file, bool write, void *data, size_t size)
+{
+    return (write ? fwrite(data, size, 1, file) : fread(data, size, 1, file)) == 1;
+}
+
+bool Binary_Header(FILE *file, bool write, const char *magic, int version, const int *layout, int layoutAmount)
+{
+    assert(layoutAmount > 0 && layoutAmount <= BINARY_LAYOUT_MAX, "Binary: layout too long");
+    char expectedMagic[BINARY_MAGIC_LEN] = {0};
+    strncpy(expectedMagic, magic, BINARY_MAGIC_LEN-1);
+    char fileMagic[BINARY_MAGIC_LEN];
+    int fileVersion = version;
+    int fileLayout[BINARY_LAYOUT_MAX];
+    memcpy(fileMagic, expectedMagic, sizeof(fileMagic));
+    memcpy(fileLayout, layout, layoutAmount * sizeof(int));
+    return TRANSFER(fileMagic) && TRANSFER(fileVersion) && Binary_Transfer(file, write, fileLayout, layoutAmount * sizeof(int)) &&
+           !memcmp(fileMagic, expectedMagic, sizeof(fileMagic)) && fileVersion == version &&
+           !memcmp(fileLayout, layout, layoutAmount * sizeof(int));
+}
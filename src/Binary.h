@@ -0,0 +1,31 @@
+#ifndef H_BINARY
+#define H_BINARY
+
+///////////////////
+//  MSC Binary   //
+///////////////////
+//Fields of the binary files: snapshots, journals, traces and trial logs.
+//Each file starts with a header of a magic, a version and the layout (struct
+//sizes and limits) its records depend on, so a file from another build is rejected.
+
+//References//
+//-----------//
+#include <stdio.h>
+#include <string.h>
+#include "Globals.h"
+
+//Parameters//
+//----------//
+#define BINARY_MAGIC_LEN 8
+#define BINARY_LAYOUT_MAX 16
+
+//Methods//
+//-------//
+//the same functions write and read a format, so both agree on it
+#define TRANSFER(x) Binary_Transfer(file, write, &(x), sizeof(x))
+//Writes or reads one field
+bool Binary_Transfer(FILE *file, bool write, void *data, size_t size);
+//Writes the header, or reads it, failing if it differs from the one of this build
+bool Binary_Header(FILE *file, bool write, const char *magic, int version, const int *layout, int layoutAmount);
+
+#endif
@@ -7,6 +7,17 @@ void Concept_SetTerm(Concept *concept, Term term)
     //concept->term_hash = Term_Hash(&term);
 }
 
+long Concept_TablesVersion(Concept *concept)
+{
+    //versions only grow, so the sum changes with any of them
+    long version = 0;
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        version += concept->precondition_beliefs[i].version;
+    }
+    return version;
+}
+
 void Concept_Print(Concept *concept)
 {
     puts("Concept:");
@@ -21,6 +21,8 @@
 //--------------//
 typedef struct {
     int id;
+    //unique per concept that entered memory, to validate cached lookups
+    long generation;
     Usage usage;
     Term term;
     //Term_HASH_TYPE term_hash;
@@ -28,14 +30,20 @@ typedef struct {
     Event incoming_goal_spike;
     Event goal_spike;
     Table precondition_beliefs[OPERATIONS_MAX];
+    //last best-first planner search which reached the concept
+    long planner_search;
+#ifndef MSC_LEAN
     //For debugging:
     char debug[50];
+#endif
 } Concept;
 
 //Methods//
 //-------//
 //Assign a new name to a concept
 void Concept_SetTerm(Concept *concept, Term term);
+//Changes whenever one of the precondition tables changes
+long Concept_TablesVersion(Concept *concept);
 //print a concept
 void Concept_Print(Concept *concept);
 
@@ -1,5 +1,83 @@
 #include "Cycle.h"
 
+bool BEST_FIRST_PLANNING = BEST_FIRST_PLANNING_INITIAL;
+long MINING_HORIZON = MINING_HORIZON_INITIAL;
+bool MINING_ADJACENT_OPERATIONS = MINING_ADJACENT_OPERATIONS_INITIAL;
+int propagation_iterations_used = 0;
+int planner_expansions_used = 0;
+bool PLAN_CACHE = PLAN_CACHE_INITIAL;
+long plan_cache_hits = 0;
+long plan_cache_misses = 0;
+bool REBUILD_ON_CHANGE = REBUILD_ON_CHANGE_INITIAL;
+int cycle_work_skipped = 0;
+long cycle_work_skipped_total = 0;
+
+//Subgoals waiting for expansion by the best-first planner
+typedef struct
+{
+    Event goal;
+    //the plan step and implication it was derived from
+    int step;
+    Implication *imp;
+    int depth;
+} Cycle_Subgoal;
+static Cycle_Subgoal planner_subgoals[PLANNER_FRONTIER_SIZE];
+static Item planner_items[PLANNER_FRONTIER_SIZE];
+static PriorityQueue planner_frontier;
+
+//A plan is the order in which the planner expands the subgoals of a goal,
+//each derived from an earlier one by one implication
+typedef struct
+{
+    Concept *concept;
+    long generation;
+    long tablesVersion;
+    int parent;
+    Implication *imp;
+} Cycle_PlanStep;
+typedef struct
+{
+    Concept *goalConcept;
+    Truth goalTruth;
+    int iterations;
+    double threshold;
+    int stepsAmount;
+    Cycle_PlanStep steps[PLAN_STEPS_MAX];
+} Cycle_Plan;
+static Cycle_Plan plan_cache[PLAN_CACHE_SIZE];
+static int plan_cache_next = 0;
+static Cycle_PlanStep planner_steps[CONCEPTS_MAX];
+static Event planner_events[CONCEPTS_MAX];
+//the concepts which received a goal spike since the spikes were last removed, all of them once it overflows
+static Concept *spiked_concepts[CONCEPTS_MAX];
+static int spiked_amount = 0;
+static bool spiked_all = false;
+
+void Cycle_INIT(void)
+{
+    //a reset or loaded memory may reuse the generations the plans were validated by
+    for(int i=0; i<PLAN_CACHE_SIZE; i++)
+    {
+        plan_cache[i].goalConcept = NULL;
+    }
+    plan_cache_next = 0;
+    //the spikes may be left over from a cycle which ended early
+    spiked_amount = 0;
+    spiked_all = true;
+}
+
+static void Cycle_MarkSpiked(Concept *c)
+{
+    if(spiked_amount < CONCEPTS_MAX)
+    {
+        spiked_concepts[spiked_amount++] = c;
+    }
+    else
+    {
+        spiked_all = true;
+    }
+}
+
 //doing inference within the matched concept, returning whether decisionMaking should continue
 static Decision Cycle_ActivateConcept(Concept *c, Event *e, long currentTime)
 {
@@ -11,7 +89,7 @@ static Decision Cycle_ActivateConcept(Concept *c, Event *e, long currentTime)
         //add event as spike to the concept:
         if(eMatch.type == EVENT_TYPE_BELIEF)
         {
-            c->belief_spike = eMatch;
+            Memory_SpikeBelief(c, &eMatch);
         }
         else
         {
@@ -20,6 +98,7 @@ static Decision Cycle_ActivateConcept(Concept *c, Event *e, long currentTime)
             if(!decision.execute)
             {
                 c->incoming_goal_spike = eMatch;
+                Cycle_MarkSpiked(c);
             }
             else
             {
@@ -35,25 +114,24 @@ static Decision Cycle_ProcessEvent(Event *e, long currentTime)
 {
     Decision decision = {0};
     e->processed = true;
-    Event_SetTerm(e, e->term); // TODO make sure that hash needs to be calculated once instead already
     IN_DEBUG( puts("Event was selected:"); Event_Print(e); )
     //determine the concept it is related to
-    int closest_concept_i;
-    Concept *c = NULL;
-    if(Memory_FindConceptByTerm(&e->term, /*e->term_hash,*/ &closest_concept_i))
+    Concept *c = Memory_ResolveConcept(e);
+    if(c != NULL)
     {
-        c = concepts.items[closest_concept_i].address;
         decision = Cycle_ActivateConcept(c, e, currentTime);
     }
-    //add a new concept for e too at the end
-    Memory_Conceptualize(&e->term);
+    //add a new concept for e too at the end (the cached handle makes this cheap if it exists)
+    Memory_ConceptualizeEvent(e);
     return decision;
 }
 
 //Propagate spikes for subgoal processing, generating anticipations and decisions
-static Decision Cycle_PropagateSpikes(long currentTime)
+//converged is set if the sweep left no new above-threshold goal spike to process or propagate, so a further sweep would change nothing
+static Decision Cycle_PropagateSpikes(long currentTime, bool *converged)
 {
     Decision decision = {0};
+    *converged = true;
     //process spikes
     if(PROPAGATE_GOAL_SPIKES)
     {
@@ -70,19 +148,29 @@ static Decision Cycle_PropagateSpikes(long currentTime)
                         Implication *imp = &postc->precondition_beliefs[opi].array[j];
                         if(!Memory_ImplicationValid(imp))
                         {
-                            Table_Remove(&postc->precondition_beliefs[opi], j);
+                            Memory_RemoveImplication(postc, opi, j);
                             j--;
                             continue;
                         }
-                        Concept *pre = imp->sourceConcept;
+                        Concept *pre = Memory_SourceConcept(imp);
                         if(pre->incoming_goal_spike.type == EVENT_TYPE_DELETED || pre->incoming_goal_spike.processed)
                         {
+                            //a concept with a spike of either kind was recorded when it got its first one
+                            if(pre->incoming_goal_spike.type == EVENT_TYPE_DELETED && pre->goal_spike.type == EVENT_TYPE_DELETED)
+                            {
+                                Cycle_MarkSpiked(pre);
+                            }
                             pre->incoming_goal_spike = Inference_GoalDeduction(&postc->goal_spike, &postc->precondition_beliefs[opi].array[j]);
+                            IN_PROFILING( profile_stats.spikesPropagated++; )
                         }
                     }
                 }
             }
-            postc->goal_spike.propagated = true;
+            //only a spike is marked, so the concepts without one are left untouched
+            if(postc->goal_spike.type != EVENT_TYPE_DELETED)
+            {
+                postc->goal_spike.propagated = true;
+            }
         }
         //process incoming goal spikes, invoking potential operations
         for(int i=0; i<concepts.itemsAmount; i++)
@@ -91,64 +179,309 @@ static Decision Cycle_PropagateSpikes(long currentTime)
             if(c->incoming_goal_spike.type != EVENT_TYPE_DELETED)
             {
                 c->goal_spike = Inference_IncreasedActionPotential(&c->goal_spike, &c->incoming_goal_spike, currentTime);
+                //the next sweep will propagate this spike
+                if(c->goal_spike.type != EVENT_TYPE_DELETED && !c->goal_spike.propagated && Truth_Expectation(c->goal_spike.truth) > PROPAGATION_THRESHOLD)
+                {
+                    *converged = false;
+                }
                 if(c->goal_spike.type != EVENT_TYPE_DELETED && !c->goal_spike.processed && Truth_Expectation(c->goal_spike.truth) > PROPAGATION_THRESHOLD)
                 {
+                    *converged = false;
                     Decision decision = Cycle_ProcessEvent(&c->goal_spike, currentTime);
                     if(decision.execute)
                     {
                         return decision;
                     }
                 }
+                c->incoming_goal_spike = (Event) {0};
             }
-            c->incoming_goal_spike = (Event) {0};
         }
     }
     return decision;
 }
 
-//Reinforce link between concept a and b (creating it if non-existent)
-static void Cycle_ReinforceLink(Event *a, Event *b, int operationID)
+static void Cycle_PushSubgoal(Event *goal, int step, Implication *imp, int depth)
+{
+    //when full the least desired subgoal is evicted and its slot reused
+    PriorityQueue_Push_Feedback feedback = PriorityQueue_Push(&planner_frontier, Truth_Expectation(goal->truth));
+    if(feedback.added)
+    {
+        Cycle_Subgoal *subgoal = feedback.addedItem.address;
+        subgoal->goal = *goal;
+        subgoal->step = step;
+        subgoal->imp = imp;
+        subgoal->depth = depth;
+    }
+}
+
+//Backward chain from an already processed goal, expanding the most desired subgoal first.
+//Deduction never raises desire, so the first time a concept is reached is with its best subgoal,
+//which becomes the next step of the plan. Returns the amount of steps.
+static int Cycle_SearchPlan(Event *goal, Concept *goalConcept)
+{
+    int stepsAmount = 0;
+    planner_search++;
+    PriorityQueue_RESET(&planner_frontier, planner_items, PLANNER_FRONTIER_SIZE);
+    for(int i=0; i<PLANNER_FRONTIER_SIZE; i++)
+    {
+        planner_items[i] = (Item) { .address = &(planner_subgoals[i]) };
+    }
+    Memory_AttachConcept(goal, goalConcept);
+    Cycle_PushSubgoal(goal, -1, NULL, 0);
+    void *popped;
+    while(PriorityQueue_PopMax(&planner_frontier, &popped))
+    {
+        //copy, as the next push may reuse the slot
+        Cycle_Subgoal subgoal = *((Cycle_Subgoal*) popped);
+        Concept *c = Memory_ResolveConcept(&subgoal.goal);
+        if(c == NULL || c->planner_search == planner_search)
+        {
+            continue;
+        }
+        c->planner_search = planner_search;
+        int step = stepsAmount++;
+        planner_events[step] = subgoal.goal;
+        planner_steps[step] = (Cycle_PlanStep) { .concept = c, .generation = c->generation, .parent = subgoal.step, .imp = subgoal.imp };
+        if(subgoal.depth < PROPAGATION_ITERATIONS && Truth_Expectation(subgoal.goal.truth) > PROPAGATION_THRESHOLD)
+        {
+            for(int opi=0; opi<OPERATIONS_MAX; opi++)
+            {
+                for(int j=0; j<c->precondition_beliefs[opi].itemsAmount; j++)
+                {
+                    Implication *imp = &c->precondition_beliefs[opi].array[j];
+                    if(!Memory_ImplicationValid(imp))
+                    {
+                        Memory_RemoveImplication(c, opi, j);
+                        j--;
+                        continue;
+                    }
+                    Concept *pre = Memory_SourceConcept(imp);
+                    if(pre->planner_search != planner_search)
+                    {
+                        Event pre_goal = Inference_GoalDeduction(&planner_events[step], imp);
+                        if(Truth_Expectation(pre_goal.truth) > PROPAGATION_THRESHOLD)
+                        {
+                            Memory_AttachConcept(&pre_goal, pre);
+                            Cycle_PushSubgoal(&pre_goal, step, imp, subgoal.depth + 1);
+                        }
+                    }
+                }
+            }
+        }
+        planner_steps[step].tablesVersion = Concept_TablesVersion(c);
+    }
+    return stepsAmount;
+}
+//The cached plan of the goal, NULL if there is none or a concept or table it was derived from changed since
+static Cycle_Plan *Cycle_LookupPlan(Event *goal, Concept *goalConcept)
+{
+    for(int i=0; i<PLAN_CACHE_SIZE; i++)
+    {
+        Cycle_Plan *plan = &plan_cache[i];
+        if(plan->stepsAmount > 0 && plan->goalConcept == goalConcept && plan->steps[0].generation == goalConcept->generation)
+        {
+            if(plan->goalTruth.frequency != goal->truth.frequency || plan->goalTruth.confidence != goal->truth.confidence ||
+               plan->iterations != PROPAGATION_ITERATIONS || plan->threshold != PROPAGATION_THRESHOLD)
+            {
+                return NULL;
+            }
+            for(int j=0; j<plan->stepsAmount; j++)
+            {
+                Cycle_PlanStep *step = &plan->steps[j];
+                if(step->concept->generation != step->generation || Concept_TablesVersion(step->concept) != step->tablesVersion)
+                {
+                    plan->stepsAmount = 0;
+                    return NULL;
+                }
+            }
+            return plan;
+        }
+    }
+    return NULL;
+}
+
+//Keep the plan just searched, replacing the goal's previous plan or else the oldest one
+static Cycle_Plan *Cycle_StorePlan(Event *goal, Concept *goalConcept, int stepsAmount)
+{
+    if(stepsAmount > PLAN_STEPS_MAX)
+    {
+        return NULL;
+    }
+    Cycle_Plan *plan = NULL;
+    for(int i=0; i<PLAN_CACHE_SIZE && plan == NULL; i++)
+    {
+        if(plan_cache[i].goalConcept == goalConcept)
+        {
+            plan = &plan_cache[i];
+        }
+    }
+    if(plan == NULL)
+    {
+        plan = &plan_cache[plan_cache_next];
+        plan_cache_next = (plan_cache_next + 1) % PLAN_CACHE_SIZE;
+    }
+    plan->goalConcept = goalConcept;
+    plan->goalTruth = goal->truth;
+    plan->iterations = PROPAGATION_ITERATIONS;
+    plan->threshold = PROPAGATION_THRESHOLD;
+    plan->stepsAmount = stepsAmount;
+    memcpy(plan->steps, planner_steps, sizeof(Cycle_PlanStep) * stepsAmount);
+    return plan;
+}
+
+//Plan for an already processed goal, reusing its cached plan if still valid, and check the
+//plan's subgoals in order against the current belief spikes, stopping at the first executable decision
+static Decision Cycle_PlanBestFirst(Event *goal, long currentTime)
+{
+    Decision decision = {0};
+    planner_expansions_used = 0;
+    Concept *goalConcept = Memory_ResolveConcept(goal);
+    if(goalConcept == NULL)
+    {
+        return decision;
+    }
+    Cycle_PlanStep *steps = planner_steps;
+    int stepsAmount;
+    Cycle_Plan *plan = PLAN_CACHE ? Cycle_LookupPlan(goal, goalConcept) : NULL;
+    if(plan != NULL)
+    {
+        plan_cache_hits++;
+        steps = plan->steps;
+        stepsAmount = plan->stepsAmount;
+    }
+    else
+    {
+        stepsAmount = Cycle_SearchPlan(goal, goalConcept);
+        if(PLAN_CACHE)
+        {
+            plan_cache_misses++;
+            Cycle_StorePlan(goal, goalConcept, stepsAmount);
+        }
+    }
+    for(int i=0; i<stepsAmount; i++)
+    {
+        Cycle_PlanStep *step = &steps[i];
+        //derive the subgoal again, the goal's stamp and occurrence time being new
+        planner_events[i] = step->parent < 0 ? *goal : Inference_GoalDeduction(&planner_events[step->parent], step->imp);
+        Memory_AttachConcept(&planner_events[i], step->concept);
+        Concept *c = step->concept;
+        c->goal_spike = planner_events[i];
+        Cycle_MarkSpiked(c);
+        IN_PROFILING( profile_stats.spikesPropagated += step->parent >= 0; )
+        if(!c->goal_spike.processed)
+        {
+            decision = Cycle_ProcessEvent(&c->goal_spike, currentTime);
+            if(decision.execute)
+            {
+                return decision;
+            }
+        }
+        c->goal_spike.propagated = true;
+        planner_expansions_used++;
+    }
+    return decision;
+}
+
+//Reinforce link between concept A of a and concept B of b (creating it if non-existent)
+static void Cycle_ReinforceLink(Event *a, FIFO_Annotation *aAnnotation, Event *b, Concept *B, uint64_t bStampSignature, int operationID)
 {
-    if(a->type != EVENT_TYPE_BELIEF || b->type != EVENT_TYPE_BELIEF)
+    if(a->type != EVENT_TYPE_BELIEF)
     {
         return;
     }
-    int AConceptIndex;
-    int BConceptIndex;
-    if(Memory_FindConceptByTerm(&a->term, /*a->term_hash,*/ &AConceptIndex) &&
-       Memory_FindConceptByTerm(&b->term, /*b->term_hash,*/ &BConceptIndex))
+    Concept *A = Memory_ResolveConcept(a);
+    if(A != NULL && A != B)
     {
-        Concept *A = concepts.items[AConceptIndex].address;
-        Concept *B = concepts.items[BConceptIndex].address;
-        if(A != B)
+        //temporal induction
+        if((aAnnotation->stampSignature & bStampSignature) == 0 || !Stamp_checkOverlap(&a->stamp, &b->stamp))
         {
-            //temporal induction
-            if(!Stamp_checkOverlap(&a->stamp, &b->stamp))
+            Implication precondition_implication = Inference_BeliefInduction(a, b);
+            precondition_implication.sourceConcept = Memory_ConceptSlot(A);
+            precondition_implication.sourceConceptTerm = A->term;
+            IN_PROFILING( profile_stats.pairsMined++; )
+            if(precondition_implication.truth.confidence >= MIN_CONFIDENCE)
             {
-                Implication precondition_implication = Inference_BeliefInduction(a, b);
-                precondition_implication.sourceConcept = A;
-                precondition_implication.sourceConceptTerm = A->term;
-                if(precondition_implication.truth.confidence >= MIN_CONFIDENCE)
+                IN_PROFILING( profile_stats.implicationsFormed++; )
+#ifdef MSC_LEAN
+                char *debug = "";
+#else
+                char debug[200];
+                sprintf(debug, "<(&/,%s,^op%d(),+%ld) =/> %s>.",A->debug, operationID,precondition_implication.occurrenceTimeOffset ,B->debug);
+#endif
+                IN_DEBUG ( if(operationID != 0) { puts(debug); Truth_Print(&precondition_implication.truth); puts("\n"); getchar(); } )
+                IN_OUTPUT( fputs("Formed implication: ", stdout); Implication_Print(&precondition_implication); )
+                EventLog_Implication(&precondition_implication, &B->term, operationID, currentTime);
+                Implication *revised_precon = Table_AddAndRevise(&B->precondition_beliefs[operationID], &precondition_implication, debug);
+                if(revised_precon != NULL)
                 {
-                    char debug[200];
-                    sprintf(debug, "<(&/,%s,^op%d(),+%ld) =/> %s>.",A->debug, operationID,precondition_implication.occurrenceTimeOffset ,B->debug);
-                    IN_DEBUG ( if(operationID != 0) { puts(debug); Truth_Print(&precondition_implication.truth); puts("\n"); getchar(); } )
-                    IN_OUTPUT( fputs("Formed implication: ", stdout); Implication_Print(&precondition_implication); )
-                    Implication *revised_precon = Table_AddAndRevise(&B->precondition_beliefs[operationID], &precondition_implication, debug);
-                    if(revised_precon != NULL)
+                    //revision always adds evidence, while an added implication keeps the induced truth
+                    IN_PROFILING( profile_stats.implicationsRevised += revised_precon->truth.confidence > precondition_implication.truth.confidence; )
+                    revised_precon->sourceConcept = Memory_ConceptSlot(A);
+                    revised_precon->sourceConceptTerm = A->term;
+                    Memory_IndexImplication(B, operationID, revised_precon);
+                    Journal_Implication(Memory_ConceptSlot(B), operationID, revised_precon);
+                    /*IN_OUTPUT( if(true && revised_precon->term_hash != 0) { fputs("REVISED pre-condition implication: ", stdout); Implication_Print(revised_precon); } ) */
+                }
+            }
+        }
+    }
+}
+
+//Mine for <(&/,precondition,operation) =/> postcondition> patterns in the FIFO,
+//the postcondition's concept is resolved once for the whole window, which ends MINING_HORIZON cycles back
+static void Cycle_MineTemporalImplications(Event *postcondition, FIFO_Annotation *postAnnotation)
+{
+    if(postcondition->type != EVENT_TYPE_BELIEF)
+    {
+        return;
+    }
+    Concept *B = Memory_ResolveConcept(postcondition);
+    if(B == NULL)
+    {
+        return;
+    }
+    uint64_t bStampSignature = postAnnotation->stampSignature;
+    int window = MINING_HORIZON > 0 ? FIFO_AmountSince(&belief_events, postcondition->occurrenceTime - MINING_HORIZON) : belief_events.itemsAmount;
+    for(int k=1; k<window; k++)
+    {
+        for(int len2=0; len2<MAX_SEQUENCE_LEN; len2++)
+        {
+            Event *precondition = FIFO_GetKthNewestSequence(&belief_events, k, len2);
+            FIFO_Annotation *preAnnotation = FIFO_GetKthNewestAnnotation(&belief_events, k, len2);
+            //if it's an operation, the preconditions are the entries which were in the FIFO when it was added,
+            //starting with the newest of them, which its annotation points to
+            int operationID = precondition->operationID;
+            if(operationID != 0) //also meaning len2==0
+            {
+                int paired = MINING_ADJACENT_OPERATIONS ? MIN(window, k+2) : window;
+                for(int j=k+1, index=preAnnotation->precondition; index >= 0 && j<paired; j++, index=(index+FIFO_SIZE-1)%FIFO_SIZE)
+                {
+                    for(int len3=0; len3<MAX_SEQUENCE_LEN; len3++)
                     {
-                        revised_precon->sourceConcept = A;
-                        revised_precon->sourceConceptTerm = A->term;
-                        /*IN_OUTPUT( if(true && revised_precon->term_hash != 0) { fputs("REVISED pre-condition implication: ", stdout); Implication_Print(revised_precon); } ) */
+                        Event *pairedPrecondition = &belief_events.array[len3][index];
+                        if(pairedPrecondition->operationID == 0)
+                        {
+                            Cycle_ReinforceLink(pairedPrecondition, &belief_events.annotations[len3][index], postcondition, B, bStampSignature, operationID);
+                        }
                     }
                 }
             }
+            else
+            {
+                Cycle_ReinforceLink(precondition, preAnnotation, postcondition, B, bStampSignature, operationID);
+            }
         }
     }
 }
 
-void Cycle_Perform(long currentTime)
-{   
+//the phases of a cycle, which ends early for an operation belief
+static void Cycle_PerformPhases(long currentTime)
+{
+    //reset before the early return of a cycle processing an operation
+    cycle_work_skipped = 0;
+    //0. anticipations which weren't confirmed in time count as negative evidence
+    Decision_ExpireAnticipations(currentTime);
+    IN_PROFILING( Profile_Lap(PROFILE_ANTICIPATIONS); )
     //1. process newest event
     if(belief_events.itemsAmount > 0)
     {
@@ -159,8 +492,10 @@ void Cycle_Perform(long currentTime)
             if(toProcess != NULL && !toProcess->processed)
             {
                 Cycle_ProcessEvent(toProcess, currentTime);
+                IN_PROFILING( Profile_Lap(PROFILE_EVENTS); )
                 Event postcondition = *toProcess;
                 Decision_AssumptionOfFailure(postcondition.operationID, currentTime); //collection of negative evidence, new way
+                IN_PROFILING( Profile_Lap(PROFILE_ASSUMPTION_OF_FAILURE); )
                 //Mine for <(&/,precondition,operation) =/> postcondition> patterns in the FIFO:
                 if(len == 0) //postcondition always len1
                 {  
@@ -168,75 +503,125 @@ void Cycle_Perform(long currentTime)
                     {
                         return;
                     }
-                    for(int k=1; k<belief_events.itemsAmount; k++)
-                    {
-                        for(int len2=0; len2<MAX_SEQUENCE_LEN; len2++)
-                        {
-                            Event *precondition = FIFO_GetKthNewestSequence(&belief_events, k, len2);
-                            if(precondition != NULL)
-                            {
-                                //if it's an operation find the real precondition and use the current one as action
-                                int operationID = precondition->operationID;
-                                if(operationID != 0) //also meaning len2==0
-                                {
-                                    for(int j=k+1; j<belief_events.itemsAmount; j++)
-                                    {
-                                        for(int len3=0; len3<MAX_SEQUENCE_LEN; len3++)
-                                        {
-                                            precondition = FIFO_GetKthNewestSequence(&belief_events, j, len3);
-                                            if(precondition != NULL && precondition->operationID == 0)
-                                            {
-                                                Cycle_ReinforceLink(precondition, &postcondition, operationID);
-                                            }
-                                        }
-                                    }
-                                }
-                                else
-                                {
-                                    Cycle_ReinforceLink(precondition, &postcondition, operationID);
-                                }
-                            }
-                        }
-                    }
+                    Decision_ConfirmAnticipations(&postcondition);
+                    IN_PROFILING( Profile_Lap(PROFILE_ANTICIPATIONS); )
+                    Cycle_MineTemporalImplications(&postcondition, FIFO_GetNewestAnnotation(&belief_events, 0));
+                    IN_PROFILING( Profile_Lap(PROFILE_MINING); )
                 }
             }
         }
     }
-    //process goals
-    Decision decision[PROPAGATION_ITERATIONS + 1] = {0};
+    //process goals, keeping the best decision (the latest one among equally desired)
+    Decision best_decision = {0};
     if(goal_events.itemsAmount > 0)
     {
         Event *goal = FIFO_GetNewestSequence(&goal_events, 0);
         if(!goal->processed)
         {
-            decision[0] = Cycle_ProcessEvent(goal, currentTime);
+            Decision decision = Cycle_ProcessEvent(goal, currentTime);
+            if(decision.execute)
+            {
+                best_decision = decision;
+            }
+            IN_PROFILING( Profile_Lap(PROFILE_GOALS); )
             //allow reasoning into the future by propagating spikes from goals back to potential current evens
-            for(int i=0; i<PROPAGATION_ITERATIONS; i++)
+            propagation_iterations_used = 0;
+            if(BEST_FIRST_PLANNING)
+            {
+                if(!decision.execute)
+                {
+                    best_decision = Cycle_PlanBestFirst(goal, currentTime);
+                }
+            }
+            else
             {
-                decision[i+1] = Cycle_PropagateSpikes(currentTime);
+                for(int i=0; i<PROPAGATION_ITERATIONS; i++)
+                {
+                    bool converged;
+                    decision = Cycle_PropagateSpikes(currentTime, &converged);
+                    propagation_iterations_used++;
+                    if(decision.execute && decision.desire >= best_decision.desire)
+                    {
+                        best_decision = decision;
+                    }
+                    if(converged && PROPAGATION_UNTIL_CONVERGENCE)
+                    {
+                        break;
+                    }
+                }
             }
         }
     }
+    IN_PROFILING( Profile_Lap(PROFILE_PROPAGATION); )
     //inject the best action if there was one
-    Decision best_decision = {0};
-    for(int i=0; i<PROPAGATION_ITERATIONS+1; i++)
-    {
-        if(decision[i].execute && decision[i].desire >= best_decision.desire)
-        {
-            best_decision = decision[i];
-        }
-    }
     if(best_decision.execute && best_decision.operationID > 0)
     {
         Decision_Execute(&best_decision);
+        IN_PROFILING( profile_stats.decisions++; Profile_Lap(PROFILE_EXECUTION); )
     }
     //end of iterations, remove spikes
-    for(int i=0; i<concepts.itemsAmount; i++)
+    if(spiked_all)
     {
-        Concept *c = concepts.items[i].address;
-        c->incoming_goal_spike = (Event) {0};
-        c->goal_spike = (Event) {0};
+        for(int i=0; i<concepts.itemsAmount; i++)
+        {
+            Concept *c = concepts.items[i].address;
+            c->incoming_goal_spike = (Event) {0};
+            c->goal_spike = (Event) {0};
+        }
+    }
+    else
+    {
+        //a concept evicted meanwhile has its slot reused, where the reset is harmless
+        for(int i=0; i<spiked_amount; i++)
+        {
+            spiked_concepts[i]->incoming_goal_spike = (Event) {0};
+            spiked_concepts[i]->goal_spike = (Event) {0};
+        }
+        cycle_work_skipped += MAX(0, concepts.itemsAmount - spiked_amount);
     }
+    spiked_amount = 0;
+    spiked_all = false;
+    IN_PROFILING( Profile_Lap(PROFILE_SPIKE_RESET); )
     //Re-sort queue
-    PriorityQueue_Rebuild(&concepts);
+    if(REBUILD_ON_CHANGE && !concepts.modified)
+    {
+        cycle_work_skipped += concepts.itemsAmount;
+    }
+    else
+    {
+        PriorityQueue_Rebuild(&concepts);
+    }
+    cycle_work_skipped_total += cycle_work_skipped;
+    IN_PROFILING( profile_stats.conceptsSkipped += cycle_work_skipped; Profile_Lap(PROFILE_REBUILD); )
+}
+
+void Cycle_Perform(long currentTime)
+{
+    bool profiled = PROFILING;
+    if(profiled)
+    {
+        Profile_Start();
+    }
+    Cycle_PerformPhases(currentTime);
+    if(profiled)
+    {
+        Profile_Stop();
+    }
+}
+
+bool Cycle_Idle(void)
+{
+    if(Decision_AnticipationsPending())
+    {
+        return false;
+    }
+    for(int len=0; len<MAX_SEQUENCE_LEN && belief_events.itemsAmount > 0; len++)
+    {
+        Event *toProcess = FIFO_GetNewestSequence(&belief_events, len);
+        if(toProcess != NULL && !toProcess->processed)
+        {
+            return false;
+        }
+    }
+    return goal_events.itemsAmount == 0 || FIFO_GetNewestSequence(&goal_events, 0)->processed;
 }
@@ -12,10 +12,56 @@
 #include "Globals.h"
 #include "Decision.h"
 #include "Inference.h"
+#include "Profile.h"
+
+//Parameters//
+//----------//
+//plan by expanding the most desired subgoal first instead of sweeping over all concepts
+#define BEST_FIRST_PLANNING_INITIAL false
+extern bool BEST_FIRST_PLANNING;
+#define PLANNER_FRONTIER_SIZE 256
+//reuse the best-first planner's subgoal order for a goal while the implications it was derived from stay unchanged.
+//Only BEST_FIRST_PLANNING plans are cached: the default sweep passes the goal spikes of all concepts on together,
+//its result depending on every spike and not only on the tables, so it's performed anew for each goal
+#define PLAN_CACHE_INITIAL true
+extern bool PLAN_CACHE;
+#define PLAN_CACHE_SIZE 16
+#define PLAN_STEPS_MAX 256
+//temporal induction only relates events occurring at most this many cycles apart, 0 for the whole FIFO
+#define MINING_HORIZON_INITIAL 0
+extern long MINING_HORIZON;
+//relate an operation only to the entries which were newest when it was added, so mining is a single pass over
+//the window rather than pairing each operation with every older entry. Off by default, as a stimulus followed by
+//another one before the operation isn't related to it anymore, and experiments 1 to 3 don't learn their mappings
+#define MINING_ADJACENT_OPERATIONS_INITIAL false
+extern bool MINING_ADJACENT_OPERATIONS;
+//only re-sort the concepts at the end of a cycle if concepts were added or removed, which leaves the concepts
+//of equal priority in their order instead of permuting them with every rebuild. Off by default, as the order
+//decides which concept is evicted and which decision ties win, so experiment 3 would train differently
+#define REBUILD_ON_CHANGE_INITIAL false
+extern bool REBUILD_ON_CHANGE;
+
+//Data structure//
+//--------------//
+//Amount of propagation sweeps the latest processed goal took
+extern int propagation_iterations_used;
+//Amount of subgoals the best-first planner expanded for the latest processed goal
+extern int planner_expansions_used;
+//Goals the best-first planner served from the plan cache, and those it had to search
+extern long plan_cache_hits;
+extern long plan_cache_misses;
+//Amount of concepts the spike removal and the re-sorting at the end of the latest cycle didn't have to visit, and the sum over all cycles
+//(while PROFILING, the sum is also counted in the stats)
+extern int cycle_work_skipped;
+extern long cycle_work_skipped_total;
 
 //Methods//
 //-------//
+//Init/Reset module
+void Cycle_INIT(void);
 //Apply one operating cyle
 void Cycle_Perform(long currentTime);
+//Whether a cycle would only remove the spikes and re-sort the concepts: no unprocessed belief or goal and no anticipation pending
+bool Cycle_Idle(void);
 
 #endif
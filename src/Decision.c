@@ -4,28 +4,199 @@ double DECISION_THRESHOLD = DECISION_THRESHOLD_INITIAL;
 double ANTICIPATION_THRESHOLD = ANTICIPATION_THRESHOLD_INITIAL;
 double ANTICIPATION_CONFIDENCE = ANTICIPATION_CONFIDENCE_INITIAL;
 double MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+int EXECUTION_MODE = EXECUTION_MODE_INITIAL;
+bool ANTICIPATION_SCHEDULED = ANTICIPATION_SCHEDULED_INITIAL;
+
+//decisions waiting for dispatch/the host, and for their operator feedback
+static Decision *action_queue = NULL;
+static int action_queue_amount = 0;
+static int action_queue_capacity = 0;
+//the copy handed to the batch dispatcher
+static Decision *action_batch = NULL;
+static int action_batch_capacity = 0;
+static Decision feedback_queue[ACTION_QUEUE_SIZE];
+static int feedback_queue_amount = 0;
+static BatchDispatcher batch_dispatcher = NULL;
+static void *batch_dispatcher_user = NULL;
+long decision_actions_dropped = 0;
+long decision_feedback_dropped = 0;
+//anticipations waiting for their consequence (ANTICIPATION_SCHEDULED)
+AnticipationWheel anticipations;
+
+void Decision_INIT(void)
+{
+    action_queue_amount = 0;
+    feedback_queue_amount = 0;
+    batch_dispatcher = NULL;
+    batch_dispatcher_user = NULL;
+    Anticipation_RESET(&anticipations, 0);
+}
+
+//append to a queue, dropping the oldest decision when full and counting it
+static void Decision_Enqueue(Decision *queue, int *amount, Decision *decision, long *dropped)
+{
+    if(*amount == ACTION_QUEUE_SIZE)
+    {
+        memmove(queue, queue+1, sizeof(Decision)*(ACTION_QUEUE_SIZE-1));
+        (*amount)--;
+        (*dropped)++;
+    }
+    queue[(*amount)++] = *decision;
+}
+
+static Decision Decision_Dequeue(Decision *queue, int *amount)
+{
+    Decision ret = queue[0];
+    (*amount)--;
+    memmove(queue, queue+1, sizeof(Decision)*(*amount));
+    return ret;
+}
+
+//make room for the amount of decisions, false if there is no memory for them
+static bool Decision_Reserve(Decision **queue, int *capacity, int amount)
+{
+    if(amount > *capacity)
+    {
+        int grown = MAX(ACTION_QUEUE_SIZE, MAX(amount, 2 * *capacity));
+        Decision *resized = realloc(*queue, sizeof(Decision)*grown);
+        if(resized == NULL)
+        {
+            return false;
+        }
+        *queue = resized;
+        *capacity = grown;
+    }
+    return true;
+}
+
+//the batch dispatcher only gets the decisions at the end of the step, so they are all kept,
+//while the host takes them whenever it wants, so only the newest ACTION_QUEUE_SIZE are
+static void Decision_EnqueueAction(Decision *decision)
+{
+    bool keepAll = EXECUTION_MODE == EXECUTION_DEFERRED && batch_dispatcher != NULL;
+    if((!keepAll && action_queue_amount >= ACTION_QUEUE_SIZE) || !Decision_Reserve(&action_queue, &action_queue_capacity, action_queue_amount+1))
+    {
+        //drop the oldest to make room, or the decision itself if there is no memory for any
+        decision_actions_dropped++;
+        if(action_queue_amount == 0)
+        {
+            return;
+        }
+        Decision_Dequeue(action_queue, &action_queue_amount);
+    }
+    action_queue[action_queue_amount++] = *decision;
+}
+
+void Decision_Invoke(Decision *decision)
+{
+    if(decision->op.contextAction != 0)
+    {
+        (*decision->op.contextAction)(decision->op.user, decision->desire);
+    }
+    else
+    {
+        (*decision->op.action)();
+    }
+}
+
 //Inject action event after execution or babbling
 void Decision_Execute(Decision *decision)
 {
     assert(decision->operationID > 0, "Operation 0 is reserved for no action");
+    Trace_Decision(decision->operationID);
     decision->op = operations[decision->operationID-1];
-    (*decision->op.action)();
+    if(EXECUTION_MODE != EXECUTION_IMMEDIATE)
+    {
+        Decision_EnqueueAction(decision);
+        Decision_Enqueue(feedback_queue, &feedback_queue_amount, decision, &decision_feedback_dropped);
+        return;
+    }
+    Decision_Invoke(decision);
     //and add operator feedback
     MSC_AddInputBelief(decision->op.term, decision->operationID);
 }
 
+void Decision_SetBatchDispatcher(BatchDispatcher dispatcher, void *user)
+{
+    batch_dispatcher = dispatcher;
+    batch_dispatcher_user = user;
+}
+
+bool Decision_BatchDispatching(void)
+{
+    return batch_dispatcher != NULL;
+}
+
+void Decision_DispatchActions(void)
+{
+    if(batch_dispatcher != NULL)
+    {
+        if(action_queue_amount > 0)
+        {
+            //queue is emptied before the call, so the dispatcher may add input
+            int amount = action_queue_amount;
+            if(!Decision_Reserve(&action_batch, &action_batch_capacity, amount))
+            {
+                amount = MIN(amount, action_batch_capacity);
+            }
+            amount = Decision_TakeActions(action_batch, amount);
+            (*batch_dispatcher)(batch_dispatcher_user, action_batch, amount);
+        }
+        return;
+    }
+    while(action_queue_amount > 0)
+    {
+        Decision decision = Decision_Dequeue(action_queue, &action_queue_amount);
+        Decision_Invoke(&decision);
+    }
+}
+
+int Decision_TakeActions(Decision *actions, int max)
+{
+    int taken = MIN(max, action_queue_amount);
+    memcpy(actions, action_queue, sizeof(Decision)*taken);
+    action_queue_amount -= taken;
+    memmove(action_queue, action_queue+taken, sizeof(Decision)*action_queue_amount);
+    return taken;
+}
+
+bool Decision_TakeFeedback(Decision *feedback)
+{
+    if(feedback_queue_amount == 0)
+    {
+        return false;
+    }
+    *feedback = Decision_Dequeue(feedback_queue, &feedback_queue_amount);
+    return true;
+}
+
+bool Decision_FeedbackPending(void)
+{
+    return feedback_queue_amount > 0;
+}
+
+bool Decision_ActionsPending(void)
+{
+    return action_queue_amount > 0;
+}
+
+bool Decision_AnticipationsPending(void)
+{
+    return anticipations.amount > 0;
+}
+
 //"reflexes" to try different operations, especially important in the beginning
 static Decision Decision_MotorBabbling(void)
 {
     Decision decision = (Decision) {0};
     int n_ops = 0;
-    for(int i=0; i<OPERATIONS_MAX && operations[i].action != 0; i++)
+    for(int i=0; i<OPERATIONS_MAX && Memory_OperationRegistered(i); i++)
     {
         n_ops = i+1;
     }
     if(n_ops > 0)
     {
-        decision.operationID = 1+(rand() % (n_ops));
+        decision.operationID = 1+(Trace_Rand() % (n_ops));
         IN_DEBUG (
             printf(" MSC BABBLE %d\n", decision.operationID);
         )
@@ -34,20 +205,18 @@ static Decision Decision_MotorBabbling(void)
     return decision;
 }
 
-int stampID = -1;
 Decision Decision_BestCandidate(Event *goal, long currentTime)
 {
     Decision decision = (Decision) {0};
-    int closest_postc_i;
-    if(Memory_FindConceptByTerm(&goal->term, /*goal->term_hash,*/ &closest_postc_i))
+    Concept *postc = Memory_ResolveConcept(goal);
+    if(postc != NULL)
     {
-        Concept *postc = concepts.items[closest_postc_i].address;
         double bestTruthExpectation = 0;
         Implication bestImp = {0};
         Concept *prec;
         for(int opi=1; opi<OPERATIONS_MAX; opi++)
         {
-            if(operations[opi-1].action == 0)
+            if(!Memory_OperationRegistered(opi-1))
             {
                 break;
             }
@@ -55,18 +224,19 @@ Decision Decision_BestCandidate(Event *goal, long currentTime)
             {
                 if(!Memory_ImplicationValid(&postc->precondition_beliefs[opi].array[j]))
                 {
-                    Table_Remove(&postc->precondition_beliefs[opi], j);
+                    Memory_RemoveImplication(postc, opi, j);
                     j--;
                     continue;
                 }
                 Implication imp = postc->precondition_beliefs[opi].array[j];
                 IN_DEBUG
                 (
-                    printf("CONSIDERED IMPLICATION: impTruth=(%f, %f) %s \n", imp.truth.frequency, imp.truth.confidence, imp.debug);
+                    char name[MEMORY_NAME_LEN];
+                    printf("CONSIDERED IMPLICATION: impTruth=(%f, %f) %s \n", imp.truth.frequency, imp.truth.confidence, Memory_ImplicationName(&imp, postc, opi, name));
                     Term_Print(&imp.term);
                 )
                 //now look at how much the precondition is fulfilled
-                Concept *current_prec = imp.sourceConcept;
+                Concept *current_prec = Memory_SourceConcept(&imp);
                 Event *precondition = &current_prec->belief_spike; //a. :|:
                 if(precondition != NULL)
                 {
@@ -74,7 +244,8 @@ Decision Decision_BestCandidate(Event *goal, long currentTime)
                     double operationGoalTruthExpectation = Truth_Expectation(Inference_OperationDeduction(&ContextualOperation, precondition, currentTime).truth); //op()! :|:
                     IN_DEBUG
                     (
-                        printf("CONSIDERED PRECON: desire=%f %s\n", operationGoalTruthExpectation, current_prec->debug);
+                        char name[MEMORY_NAME_LEN];
+                        printf("CONSIDERED PRECON: desire=%f %s\n", operationGoalTruthExpectation, Memory_ConceptName(current_prec, name));
                         fputs("CONSIDERED PRECON truth ", stdout);
                         Truth_Print(&precondition->truth);
                         fputs("CONSIDERED goal truth ", stdout);
@@ -100,13 +271,16 @@ Decision Decision_BestCandidate(Event *goal, long currentTime)
         {
             return decision;
         }
-        printf("decision expectation %f impTruth=(%f, %f): %s future=%ld\n", bestTruthExpectation, bestImp.truth.frequency, bestImp.truth.confidence, bestImp.debug, bestImp.occurrenceTimeOffset);
+        EventLog_Decision(bestTruthExpectation, &bestImp, postc, &goal->term, decision.operationID, currentTime);
         IN_DEBUG
         (
-            printf("%s %f,%f",bestImp.debug, bestImp.truth.frequency, bestImp.truth.confidence);
+            char name[MEMORY_NAME_LEN];
+            char *impName = Memory_ImplicationName(&bestImp, postc, decision.operationID, name);
+            char precName[MEMORY_NAME_LEN];
+            printf("%s %f,%f",impName, bestImp.truth.frequency, bestImp.truth.confidence);
             puts("");
-            printf("SELECTED PRECON: %s\n", prec->debug);
-            puts(bestImp.debug); //++
+            printf("SELECTED PRECON: %s\n", Memory_ConceptName(prec, precName));
+            puts(impName); //++
             printf(" MSC TAKING ACTIVE CONTROL %d\n", decision.operationID);
         )
         decision.execute = true;
@@ -115,9 +289,72 @@ Decision Decision_BestCandidate(Event *goal, long currentTime)
     return decision;
 }
 
-void Decision_AssumptionOfFailure(int operationID, long currentTime)
+//revise the implication with negative evidence
+static void Decision_AddNegativeEvidence(Concept *postc, int operationID, Implication *imp, Truth truth)
+{
+    Implication negative_confirmation = *imp;
+    negative_confirmation.truth = truth;
+    negative_confirmation.stamp = (Stamp) { .evidentalBase = { -stampID } };
+    IN_DEBUG ( char name[MEMORY_NAME_LEN]; printf("ANTICIPATE %s, future=%ld \n", Memory_ImplicationName(imp, postc, operationID, name), imp->occurrenceTimeOffset); )
+    assert(negative_confirmation.truth.confidence >= 0.0 && negative_confirmation.truth.confidence <= 1.0, "(666) confidence out of bounds");
+#ifdef MSC_LEAN
+    char *debug = ""; //not stored in a lean build
+#else
+    char *debug = negative_confirmation.debug;
+#endif
+    Implication *added = Table_AddAndRevise(&postc->precondition_beliefs[operationID], &negative_confirmation, debug);
+    if(added != NULL)
+    {
+        added->sourceConcept = negative_confirmation.sourceConcept;
+        added->sourceConceptTerm = negative_confirmation.sourceConceptTerm;
+        Memory_IndexImplication(postc, operationID, added);
+        Journal_Implication(Memory_ConceptSlot(postc), operationID, added);
+    }
+    stampID--;
+}
+
+//the expectation of an anticipation from the precondition can't exceed the one of an implication of full truth
+static double Decision_AnticipationBound(Event *seqop)
+{
+    Truth truth = seqop->truth;
+    return truth.confidence * truth.frequency * (truth.frequency - 0.5) + 0.5;
+}
+
+//anticipate the postcondition of the implication, if it's expected strongly enough from the precondition
+static void Decision_Anticipate(Concept *postc, int operationID, int h, Event *precondition, Event *seqop, long currentTime)
+{
+    Implication imp = postc->precondition_beliefs[operationID].array[h]; //(&/,a,op) =/> b.
+    Event result = Inference_BeliefDeduction(seqop, &imp); //b. :/:
+    if(Truth_Expectation(result.truth) > ANTICIPATION_THRESHOLD)
+    {
+        Truth TNew = { .frequency = 0.0, .confidence = ANTICIPATION_CONFIDENCE };
+        Truth TPast = Truth_Projection(precondition->truth, 0, imp.occurrenceTimeOffset);
+        Truth negative = Truth_Eternalize(Truth_Induction(TPast, TNew));
+        long due = precondition->occurrenceTime + ANTICIPATION_WINDOW * imp.occurrenceTimeOffset;
+        EventLog_Anticipation(&imp, &postc->term, operationID, negative, due, currentTime);
+        //when the wheel is full the evidence is added right away
+        if(!ANTICIPATION_SCHEDULED || !Anticipation_Schedule(&anticipations, postc, operationID, imp.term, negative, due))
+        {
+            Decision_AddNegativeEvidence(postc, operationID, &postc->precondition_beliefs[operationID].array[h], negative);
+        }
+    }
+}
+
+//(&/,a,op). :|: for the belief spike of the precondition
+static Event Decision_SequenceWithOperation(Event *precondition, int operationID, long currentTime)
+{
+    Event updated_precondition = Inference_EventUpdate(precondition, currentTime);
+    Event op = { .type = EVENT_TYPE_BELIEF,
+                 .truth = { .frequency = 1.0, .confidence = 0.9 },
+                 .occurrenceTime = currentTime,
+                 .operationID = operationID };
+    op.term.terms[0] = 42; //for now, to make sure we don't operate on an empty term here
+    return Inference_BeliefIntersection(&updated_precondition, &op);
+}
+
+//every implication of the operation is visited, in the order of the concepts
+static void Decision_AssumptionOfFailureSweep(int operationID, long currentTime)
 {
-    assert(operationID >= 0 && operationID < OPERATIONS_MAX, "Wrong operation id, did you inject an event manually?");
     for(int j=0; j<concepts.itemsAmount; j++)
     {
         Concept *postc = concepts.items[j].address;
@@ -125,40 +362,113 @@ void Decision_AssumptionOfFailure(int operationID, long currentTime)
         {
             if(!Memory_ImplicationValid(&postc->precondition_beliefs[operationID].array[h]))
             {
-                Table_Remove(&postc->precondition_beliefs[operationID], h);
+                Memory_RemoveImplication(postc, operationID, h);
                 h--;
                 continue;
             }
-            Implication imp = postc->precondition_beliefs[operationID].array[h]; //(&/,a,op) =/> b.
-            Concept *current_prec = imp.sourceConcept;
-            Event *precondition = &current_prec->belief_spike; //a. :|:
-            if(precondition != NULL && precondition->type != EVENT_TYPE_DELETED)
+            Event *precondition = &Memory_SourceConcept(&postc->precondition_beliefs[operationID].array[h])->belief_spike; //a. :|:
+            if(precondition->type != EVENT_TYPE_DELETED)
+            {
+                Event seqop = Decision_SequenceWithOperation(precondition, operationID, currentTime);
+                Decision_Anticipate(postc, operationID, h, precondition, &seqop, currentTime);
+            }
+        }
+    }
+}
+
+void Decision_AssumptionOfFailure(int operationID, long currentTime)
+{
+    assert(operationID >= 0 && operationID < OPERATIONS_MAX, "Wrong operation id, did you inject an event manually?");
+    //the evidence is added in the order of the sweep, which the indexed visit doesn't keep, so the index
+    //only serves the scheduled anticipations, whose evidence is added when they expire
+    if(!ANTICIPATION_SCHEDULED)
+    {
+        Decision_AssumptionOfFailureSweep(operationID, currentTime);
+        return;
+    }
+    //only the implications from a concept with a belief spike can anticipate, found through the index of the memory
+    Memory_UpdateIndex();
+    for(int i=0; i<belief_spike_amount; i++)
+    {
+        int preSlot = belief_spike_slots[i];
+        Concept *current_prec = &concept_storage[preSlot];
+        Event *precondition = &current_prec->belief_spike; //a. :|:
+        if(current_prec->generation == 0 || precondition->type == EVENT_TYPE_DELETED)
+        {
+            Memory_UnlistBeliefSpike(i--);
+            continue;
+        }
+        Event seqop = Decision_SequenceWithOperation(precondition, operationID, currentTime);
+        //the spike of the past only weakens from here on, and can't anticipate anymore once below the threshold
+        if(Decision_AnticipationBound(&seqop) <= ANTICIPATION_THRESHOLD)
+        {
+            if(precondition->occurrenceTime <= currentTime && ANTICIPATION_THRESHOLD >= 0.5)
+            {
+                Memory_UnlistBeliefSpike(i--);
+            }
+            continue;
+        }
+        int slot = 0;
+        Concept *postc;
+        while((postc = Memory_NextPostcondition(preSlot, operationID, &slot)) != NULL)
+        {
+            //terms are unique within a table, so only one valid implication can be from the precondition
+            bool indexed = false;
+            Table *table = &postc->precondition_beliefs[operationID];
+            for(int h=0; h<table->itemsAmount; h++)
             {
-                Event updated_precondition = Inference_EventUpdate(precondition, currentTime);
-                Event op = { .type = EVENT_TYPE_BELIEF,
-                             .truth = { .frequency = 1.0, .confidence = 0.9 },
-                             .occurrenceTime = currentTime,
-                             .operationID = operationID };
-                op.term.terms[0] = 42; //for now, to make sure we don't operate on an empty term here
-                Event seqop = Inference_BeliefIntersection(&updated_precondition, &op); //(&/,a,op). :|:
-                Event result = Inference_BeliefDeduction(&seqop, &imp); //b. :/:
-                if(Truth_Expectation(result.truth) > ANTICIPATION_THRESHOLD)
+                if(table->array[h].sourceConcept != preSlot)
                 {
-                    Implication negative_confirmation = imp;
-                    Truth TNew = { .frequency = 0.0, .confidence = ANTICIPATION_CONFIDENCE };
-                    Truth TPast = Truth_Projection(precondition->truth, 0, imp.occurrenceTimeOffset);
-                    negative_confirmation.truth = Truth_Eternalize(Truth_Induction(TPast, TNew));
-                    negative_confirmation.stamp = (Stamp) { .evidentalBase = { -stampID } };
-                    IN_DEBUG ( printf("ANTICIPATE %s, future=%ld \n", imp.debug, imp.occurrenceTimeOffset); )
-                    assert(negative_confirmation.truth.confidence >= 0.0 && negative_confirmation.truth.confidence <= 1.0, "(666) confidence out of bounds");
-                    Implication *added = Table_AddAndRevise(&postc->precondition_beliefs[operationID], &negative_confirmation, negative_confirmation.debug);
-                    if(added != NULL)
-                    {
-                        added->sourceConcept = negative_confirmation.sourceConcept;
-                        added->sourceConceptTerm = negative_confirmation.sourceConceptTerm;
-                    }                                
-                    stampID--;
+                    continue;
+                }
+                if(!Memory_ImplicationValid(&table->array[h]))
+                {
+                    Memory_RemoveImplication(postc, operationID, h);
+                    h--;
+                    continue;
+                }
+                indexed = true;
+                Decision_Anticipate(postc, operationID, h, precondition, &seqop, currentTime);
+                break;
+            }
+            if(!indexed)
+            {
+                Memory_UnindexImplication(preSlot, operationID, postc);
+            }
+        }
+    }
+}
+
+void Decision_ConfirmAnticipations(Event *belief)
+{
+    Concept *c = Memory_ResolveConcept(belief);
+    if(c != NULL)
+    {
+        Anticipation_Confirm(&anticipations, c);
+    }
+}
+
+void Decision_ExpireAnticipations(long currentTime)
+{
+    Anticipation expired;
+    while(Anticipation_PopExpired(&anticipations, currentTime, &expired))
+    {
+        Concept *postc = expired.postcondition;
+        if(postc->generation != expired.generation)
+        {
+            continue;
+        }
+        //the implication may have been revised or removed meanwhile
+        Table *table = &postc->precondition_beliefs[expired.operationID];
+        for(int h=0; h<table->itemsAmount; h++)
+        {
+            if(Term_Equal(&table->array[h].term, &expired.precondition))
+            {
+                if(Memory_ImplicationValid(&table->array[h]))
+                {
+                    Decision_AddNegativeEvidence(postc, expired.operationID, &table->array[h], expired.truth);
                 }
+                break;
             }
         }
     }
@@ -170,7 +480,7 @@ Decision Decision_Suggest(Event *goal, long currentTime)
     // First try to use learned knowledge.
     decision = Decision_BestCandidate(goal, currentTime);
     // Fall back to exploration if nothing suitable was found.
-    if(!decision.execute && rand() % 1000000 < (int)(MOTOR_BABBLING_CHANCE*1000000.0))
+    if(!decision.execute && Trace_Rand() % 1000000 < (int)(MOTOR_BABBLING_CHANCE*1000000.0))
     {
         decision = Decision_MotorBabbling();
     }
@@ -6,6 +6,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include "Memory.h"
+#include "Anticipation.h"
+#include "Trace.h"
+#include "EventLog.h"
 #include "MSC.h"
 
 ////////////////////
@@ -22,9 +25,22 @@ extern double DECISION_THRESHOLD;
 extern double ANTICIPATION_THRESHOLD;
 #define ANTICIPATION_CONFIDENCE_INITIAL 0.005
 extern double ANTICIPATION_CONFIDENCE;
+//instead of adding the negative evidence right away, wait for the anticipated
+//event until ANTICIPATION_WINDOW times its expected delay and only add it if it didn't happen
+#define ANTICIPATION_SCHEDULED_INITIAL false
+extern bool ANTICIPATION_SCHEDULED;
+#define ANTICIPATION_WINDOW 2
 //motor babbling chance
 #define MOTOR_BABBLING_CHANCE_INITIAL 0.2
 extern double MOTOR_BABBLING_CHANCE;
+//how chosen operations are executed:
+#define EXECUTION_IMMEDIATE 0 //callback and operator feedback within the current cycle (nested cycle)
+#define EXECUTION_DEFERRED 1  //callback after the cycle, operator feedback at the next cycle boundary
+#define EXECUTION_HOST 2      //handed to the host via Decision_TakeActions, feedback at the next cycle boundary
+#define EXECUTION_MODE_INITIAL EXECUTION_IMMEDIATE
+extern int EXECUTION_MODE;
+//decisions queued for the host and operator feedback waiting, the oldest being dropped beyond
+#define ACTION_QUEUE_SIZE 16
 
 //Data structure//
 //--------------//
@@ -35,13 +51,45 @@ typedef struct
     int operationID;
     Operation op;
 }Decision;
+//receives all decisions of a step at once (EXECUTION_DEFERRED), instead of the operation callbacks,
+//the queue growing beyond ACTION_QUEUE_SIZE for a step of more decisions
+typedef void (*BatchDispatcher)(void *user, Decision *decisions, int amount);
+//anticipations scheduled for confirmation (ANTICIPATION_SCHEDULED)
+extern AnticipationWheel anticipations;
+//queued decisions and operator feedback which were dropped for a newer one, as their queue was full
+extern long decision_actions_dropped;
+extern long decision_feedback_dropped;
 
 //Methods//
 //-------//
-//execute decision
+//Init/Reset module
+void Decision_INIT(void);
+//execute decision, or queue it if execution is not immediate
 void Decision_Execute(Decision *decision);
+//invoke the registered callback of the decision's operation
+void Decision_Invoke(Decision *decision);
+//invoke the callbacks of the queued decisions, or hand them to the batch dispatcher (EXECUTION_DEFERRED)
+void Decision_DispatchActions(void);
+//register a dispatcher receiving all decisions of a step, NULL to invoke the callbacks individually
+void Decision_SetBatchDispatcher(BatchDispatcher dispatcher, void *user);
+//whether a batch dispatcher is registered
+bool Decision_BatchDispatching(void);
+//hand the queued decisions to the host (EXECUTION_HOST), returns how many were taken
+int Decision_TakeActions(Decision *actions, int max);
+//take the operator feedback of a queued decision, to be injected at the cycle boundary
+bool Decision_TakeFeedback(Decision *feedback);
+//whether operator feedback is waiting for the next cycle boundary
+bool Decision_FeedbackPending(void);
+//whether decisions are queued for dispatch or for the host
+bool Decision_ActionsPending(void);
+//whether scheduled anticipations wait for confirmation or expiry (ANTICIPATION_SCHEDULED)
+bool Decision_AnticipationsPending(void);
 //assumption of failure, also works for "do nothing operator"
 void Decision_AssumptionOfFailure(int operationID, long currentTime);
+//the belief happened, so its scheduled anticipations are confirmed (ANTICIPATION_SCHEDULED)
+void Decision_ConfirmAnticipations(Event *belief);
+//add the negative evidence of the scheduled anticipations due before currentTime (ANTICIPATION_SCHEDULED)
+void Decision_ExpireAnticipations(long currentTime);
 //MSC decision making rule applying when goal is an operation
 Decision Decision_Suggest(Event *goal, long currentTime);
 
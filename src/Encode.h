@@ -18,11 +18,15 @@
 //----------//
 #define TERMS_MAX 255
 #define TERMS_LEN 255
+//the term numbers a Term holds as positive char, so only as many names can be encoded
+#define TERMS_ENCODABLE 127
 #define TERM_ONES 5
 
 //Data structure//
 //--------------//
 char *terms[TERMS_MAX];
+//amount of encoded terms, term i+1 being named terms[i]
+extern int term_index;
 
 //Methods//
 //-------//
@@ -3,11 +3,13 @@
 void Event_SetTerm(Event *event, Term term)
 {
     event->term = term;
+    event->conceptGeneration = 0;
     //Generate hash too:
     //event->term_hash = Term_Hash(&term);
 }
 
 long base = 1;
+int stampID = -1;
 Event Event_InputEvent(Term term, char type, Truth truth, long currentTime)
 {
     return (Event) { .term = term,
@@ -25,7 +27,11 @@ void Event_INIT(void)
 
 void Event_Print(Event *event)
 {
+#ifdef MSC_LEAN
+    puts("Event:");
+#else
     printf("Event: %s\n", event->debug);
+#endif
     Term_Print(&event->term);
     //printf("Term hash=%d", event->term_hash);
     printf(event->type == EVENT_TYPE_GOAL ? "type=goal\n" : (EVENT_TYPE_BELIEF ? "type=belief\n" : "type=deleted\n" ));
@@ -25,14 +25,24 @@ typedef struct {
     int operationID; //automatically obtained from Term on input
     bool processed;
     bool propagated;
+    //cached concept lookup: slot in concept storage and the concept's generation there,
+    //0 if not resolved yet, negative (see Memory_ResolveConcept) if no concept was found
+    int conceptSlot;
+    long conceptGeneration;
+#ifndef MSC_LEAN
     char debug[30];
+#endif
 } Event;
+//evidental base of the next input event
+extern long base;
+//evidental base of the next negative evidence, counting down
+extern int stampID;
 
 //Methods//
 //-------//
 //Init/Reset module
 void Event_INIT(void);
-//Assign a new name to an event
+//Assign a new name to an event, dropping its cached concept
 void Event_SetTerm(Event *event, Term term);
 //construct an input event
 Event Event_InputEvent(Term term, char type, Truth truth, long currentTime);
@@ -0,0 +1,231 @@
+#include "EventLog.h"
+
+int EVENTLOG_LEVEL[EVENTLOG_CATEGORIES] = { EVENTLOG_DECISION_LEVEL_INITIAL, EVENTLOG_INPUT_LEVEL_INITIAL,
+                                            EVENTLOG_IMPLICATION_LEVEL_INITIAL, EVENTLOG_ANTICIPATION_LEVEL_INITIAL };
+unsigned long eventlog_dropped = 0;
+
+static Ring eventlog_ring;
+static EventLog_Record eventlog_records[EVENTLOG_RING_SIZE];
+
+static pthread_t eventlog_drainer;
+static bool eventlog_draining = false;
+static bool eventlog_stop = false;
+static FILE *eventlog_out = NULL;
+static bool eventlog_text = false;
+
+void EventLog_RESET(void)
+{
+    Ring_RESET(&eventlog_ring);
+    eventlog_dropped = 0;
+}
+
+static void EventLog_Put(EventLog_Record *record)
+{
+    int slot = Ring_Reserve(&eventlog_ring, EVENTLOG_RING_SIZE);
+    if(slot < 0)
+    {
+        eventlog_dropped++;
+        return;
+    }
+    eventlog_records[slot] = *record;
+    Ring_Commit(&eventlog_ring);
+}
+
+void EventLog_Decision(double expectation, Implication *imp, Concept *postc, Term *goal, int operationID, long time)
+{
+    if(EVENTLOG_LEVEL[EVENTLOG_DECISION] == EVENTLOG_PRINT)
+    {
+        char name[MEMORY_NAME_LEN];
+        printf("decision expectation %f impTruth=(%f, %f): %s future=%ld\n", expectation, imp->truth.frequency, imp->truth.confidence,
+               Memory_ImplicationName(imp, postc, operationID, name), imp->occurrenceTimeOffset);
+    }
+    else if(EVENTLOG_LEVEL[EVENTLOG_DECISION] == EVENTLOG_RING)
+    {
+        EventLog_Put(&(EventLog_Record) { .category = EVENTLOG_DECISION, .operationID = operationID, .time = time, .term = imp->term,
+                                          .postcondition = *goal, .truth = imp->truth, .expectation = expectation,
+                                          .offset = imp->occurrenceTimeOffset });
+    }
+}
+
+void EventLog_Input(int conceptID, Term *term, char type, Truth truth, int operationID, long time)
+{
+    if(EVENTLOG_LEVEL[EVENTLOG_INPUT] == EVENTLOG_PRINT)
+    {
+        printf("Input: %d%s :|: %%%f;%f%%\n", conceptID, type == EVENT_TYPE_BELIEF ? "." : "!", truth.frequency, truth.confidence);
+    }
+    else if(EVENTLOG_LEVEL[EVENTLOG_INPUT] == EVENTLOG_RING)
+    {
+        EventLog_Put(&(EventLog_Record) { .category = EVENTLOG_INPUT, .type = type, .operationID = operationID, .time = time,
+                                          .term = *term, .truth = truth });
+    }
+}
+
+void EventLog_Implication(Implication *imp, Term *postcondition, int operationID, long time)
+{
+    if(EVENTLOG_LEVEL[EVENTLOG_IMPLICATION] != EVENTLOG_OFF)
+    {
+        EventLog_Record record = { .category = EVENTLOG_IMPLICATION, .operationID = operationID, .time = time, .term = imp->term,
+                                   .postcondition = *postcondition, .truth = imp->truth, .offset = imp->occurrenceTimeOffset };
+        if(EVENTLOG_LEVEL[EVENTLOG_IMPLICATION] == EVENTLOG_PRINT)
+        {
+            EventLog_Print(&record, stdout);
+        }
+        else
+        {
+            EventLog_Put(&record);
+        }
+    }
+}
+
+void EventLog_Anticipation(Implication *imp, Term *postcondition, int operationID, Truth negative, long due, long time)
+{
+    if(EVENTLOG_LEVEL[EVENTLOG_ANTICIPATION] != EVENTLOG_OFF)
+    {
+        EventLog_Record record = { .category = EVENTLOG_ANTICIPATION, .operationID = operationID, .time = time, .term = imp->term,
+                                   .postcondition = *postcondition, .truth = negative, .offset = imp->occurrenceTimeOffset,
+                                   .due = due };
+        if(EVENTLOG_LEVEL[EVENTLOG_ANTICIPATION] == EVENTLOG_PRINT)
+        {
+            EventLog_Print(&record, stdout);
+        }
+        else
+        {
+            EventLog_Put(&record);
+        }
+    }
+}
+
+bool EventLog_Take(EventLog_Record *record)
+{
+    int slot = Ring_Front(&eventlog_ring, EVENTLOG_RING_SIZE);
+    if(slot < 0)
+    {
+        return false;
+    }
+    *record = eventlog_records[slot];
+    Ring_Release(&eventlog_ring);
+    return true;
+}
+
+//where the dictionary can't be read
+static void EventLog_PrintNumber(FILE *out, int number)
+{
+    fprintf(out, "%d", number);
+}
+
+static void EventLog_PrintName(FILE *out, int number)
+{
+    if(number <= term_index)
+    {
+        fputs(terms[number-1], out);
+    }
+    else
+    {
+        EventLog_PrintNumber(out, number);
+    }
+}
+
+//<(&/,precondition,^opN,+offset) =/> postcondition>
+static void EventLog_PrintImplication(EventLog_Record *record, Term_Atom atom, FILE *out)
+{
+    fputs("<(&/,", out);
+    Term_Format(out, &record->term, atom);
+    fprintf(out, ",^op%d(),+%ld) =/> ", record->operationID, record->offset);
+    Term_Format(out, &record->postcondition, atom);
+    fputc('>', out);
+}
+
+static void EventLog_Write(EventLog_Record *record, Term_Atom atom, FILE *out)
+{
+    fprintf(out, "%ld ", record->time);
+    switch(record->category)
+    {
+        case EVENTLOG_DECISION:
+            fprintf(out, "decision ^op%d expectation=%f for ", record->operationID, record->expectation);
+            Term_Format(out, &record->postcondition, atom);
+            fputs(" by ", out);
+            EventLog_PrintImplication(record, atom, out);
+            break;
+        case EVENTLOG_INPUT:
+            fputs("input ", out);
+            Term_Format(out, &record->term, atom);
+            fputs(record->type == EVENT_TYPE_BELIEF ? ". :|:" : "! :|:", out);
+            break;
+        case EVENTLOG_IMPLICATION:
+            fputs("implication ", out);
+            EventLog_PrintImplication(record, atom, out);
+            fputc('.', out);
+            break;
+        case EVENTLOG_ANTICIPATION:
+            fprintf(out, "anticipation due=%ld ", record->due);
+            EventLog_PrintImplication(record, atom, out);
+            fputc('.', out);
+            break;
+    }
+    fprintf(out, " %%%f;%f%%\n", record->truth.frequency, record->truth.confidence);
+}
+
+void EventLog_Print(EventLog_Record *record, FILE *out)
+{
+    EventLog_Write(record, EventLog_PrintName, out);
+}
+
+int EventLog_Drain(FILE *out, bool text)
+{
+    int amount = 0;
+    EventLog_Record record;
+    while(EventLog_Take(&record))
+    {
+        if(text)
+        {
+            //the reasoner may extend the dictionary meanwhile
+            EventLog_Write(&record, EventLog_PrintNumber, out);
+        }
+        else
+        {
+            fwrite(&record, sizeof(record), 1, out);
+        }
+        amount++;
+    }
+    return amount;
+}
+
+static void *EventLog_Drainer(void *unused)
+{
+    (void) unused;
+    struct timespec interval = { .tv_sec = 0, .tv_nsec = EVENTLOG_DRAIN_INTERVAL_NS };
+    while(!LOAD_ACQUIRE(eventlog_stop))
+    {
+        if(EventLog_Drain(eventlog_out, eventlog_text) == 0)
+        {
+            nanosleep(&interval, NULL);
+        }
+    }
+    //what the reasoner logged before it stopped the drainer
+    EventLog_Drain(eventlog_out, eventlog_text);
+    fflush(eventlog_out);
+    return NULL;
+}
+
+bool EventLog_StartDrainer(FILE *out, bool text)
+{
+    if(eventlog_draining)
+    {
+        return false;
+    }
+    eventlog_out = out;
+    eventlog_text = text;
+    eventlog_stop = false;
+    eventlog_draining = pthread_create(&eventlog_drainer, NULL, EventLog_Drainer, NULL) == 0;
+    return eventlog_draining;
+}
+
+void EventLog_StopDrainer(void)
+{
+    if(eventlog_draining)
+    {
+        STORE_RELEASE(eventlog_stop, true);
+        pthread_join(eventlog_drainer, NULL);
+        eventlog_draining = false;
+    }
+}
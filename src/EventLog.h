@@ -0,0 +1,94 @@
+#ifndef H_EVENTLOG
+#define H_EVENTLOG
+
+///////////////////////
+//  MSC Event Log    //
+///////////////////////
+//Structured log of what the reasoner does: decisions, inputs, implications formed and
+//anticipations. Each category has a level: off, printed as text right away (the output
+//MSC always had), or a fixed-size binary record put into a lock-free ring buffer, which
+//costs a copy instead of formatting. The ring has one producer, the reasoner, and one
+//consumer, either the host calling EventLog_Drain or a background drainer thread.
+//Records which don't fit into a full ring are dropped and counted.
+
+//References//
+//-----------//
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include "Event.h"
+#include "Implication.h"
+#include "Memory.h"
+#include "Encode.h"
+#include "Ring.h"
+
+//Parameters//
+//----------//
+#define EVENTLOG_DECISION 0
+#define EVENTLOG_INPUT 1
+#define EVENTLOG_IMPLICATION 2
+#define EVENTLOG_ANTICIPATION 3
+#define EVENTLOG_CATEGORIES 4
+#define EVENTLOG_OFF 0
+#define EVENTLOG_RING 1
+#define EVENTLOG_PRINT 2
+#define EVENTLOG_DECISION_LEVEL_INITIAL EVENTLOG_PRINT
+#define EVENTLOG_INPUT_LEVEL_INITIAL EVENTLOG_PRINT
+#define EVENTLOG_IMPLICATION_LEVEL_INITIAL EVENTLOG_OFF
+#define EVENTLOG_ANTICIPATION_LEVEL_INITIAL EVENTLOG_OFF
+//level per category
+extern int EVENTLOG_LEVEL[EVENTLOG_CATEGORIES];
+#define EVENTLOG_RING_SIZE 4096 //has to be a power of two
+//how long the drainer sleeps when the ring is empty
+#define EVENTLOG_DRAIN_INTERVAL_NS 1000000
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    char category;
+    //EVENTLOG_INPUT: belief or goal
+    char type;
+    int operationID;
+    long time;
+    //the input, or the precondition of the implication decided with, formed or anticipated
+    Term term;
+    //the goal decided for, or the postcondition of the implication formed or anticipated
+    Term postcondition;
+    //of the input, or of the implication, or the negative evidence anticipated
+    Truth truth;
+    //EVENTLOG_DECISION: the desire of the decision
+    double expectation;
+    //the occurrence time offset of the implication
+    long offset;
+    //EVENTLOG_ANTICIPATION: when the postcondition is due
+    long due;
+} EventLog_Record;
+//records dropped because the ring was full
+extern unsigned long eventlog_dropped;
+
+//Methods//
+//-------//
+//Drop the records in the ring, must not be called while the drainer runs
+void EventLog_RESET(void);
+//Log a decision for the goal above DECISION_THRESHOLD, printed with the name of the implication into postc,
+//which a lean build formats only then
+void EventLog_Decision(double expectation, Implication *imp, Concept *postc, Term *goal, int operationID, long time);
+//Log an input event, printed with the id of its concept
+void EventLog_Input(int conceptID, Term *term, char type, Truth truth, int operationID, long time);
+//Log an implication formed by temporal induction
+void EventLog_Implication(Implication *imp, Term *postcondition, int operationID, long time);
+//Log the negative evidence anticipated for an implication whose postcondition is due
+void EventLog_Anticipation(Implication *imp, Term *postcondition, int operationID, Truth negative, long due, long time);
+//Consumer: take the oldest record out of the ring, false if it is empty
+bool EventLog_Take(EventLog_Record *record);
+//Print a record as a line of text with the names of its terms, only on the thread of the reasoner
+void EventLog_Print(EventLog_Record *record, FILE *out);
+//Consumer: write the records in the ring as text lines, with the numbers of the terms, or binary records, returning the amount written
+int EventLog_Drain(FILE *out, bool text);
+//Start a thread draining the ring into out, false if it can't be started or one runs already
+bool EventLog_StartDrainer(FILE *out, bool text);
+//Stop the drainer after it wrote the remaining records
+void EventLog_StopDrainer(void);
+
+#endif
@@ -9,6 +9,7 @@ void FIFO_RESET(FIFO *fifo)
         for(int i=0; i<FIFO_SIZE; i++)
         {
             fifo->array[len][i] = (Event) {0};
+            fifo->annotations[len][i] = (FIFO_Annotation) { .precondition = -1 };
         }
     }
 }
@@ -22,6 +23,9 @@ void FIFO_Add(Event *event, FIFO *fifo)
         if(len == 0)
         {
             fifo->array[len][fifo->currentIndex] = *event;
+            int newest = fifo->itemsAmount > 0 ? (fifo->currentIndex + FIFO_SIZE - 1) % FIFO_SIZE : -1;
+            fifo->annotations[len][fifo->currentIndex] = (FIFO_Annotation) { .stampSignature = Stamp_signature(&event->stamp),
+                                                                             .precondition = event->operationID != 0 ? newest : -1 };
         }
         else //len>0, so chain previous sequence with length len-1 with new event
         {
@@ -33,6 +37,8 @@ void FIFO_Add(Event *event, FIFO *fifo)
             //printf("occurrence times a=%d, b=%d", ((int) sequence->occurrenceTime),((int) event->occurrenceTime));
             Event new_sequence = Inference_BeliefIntersection(sequence, event);
             fifo->array[len][fifo->currentIndex] = new_sequence;
+            fifo->annotations[len][fifo->currentIndex] = (FIFO_Annotation) { .stampSignature = Stamp_signature(&new_sequence.stamp),
+                                                                             .precondition = -1 };
         }
         
     }
@@ -40,21 +46,57 @@ void FIFO_Add(Event *event, FIFO *fifo)
     fifo->itemsAmount = MIN(fifo->itemsAmount + 1, FIFO_SIZE);
 }
 
-Event* FIFO_GetKthNewestSequence(FIFO *fifo, int k, int len)
+static int FIFO_KthNewestIndex(FIFO *fifo, int k)
 {
     if(fifo->itemsAmount == 0 || k >= fifo->itemsAmount)
     {
-        return NULL;
+        return -1;
     }
     int index = fifo->currentIndex - 1 - k;
     if(index < 0)
     {
         index = FIFO_SIZE+index;
     }
-    return &fifo->array[len][index];
+    return index;
+}
+
+Event* FIFO_GetKthNewestSequence(FIFO *fifo, int k, int len)
+{
+    int index = FIFO_KthNewestIndex(fifo, k);
+    return index < 0 ? NULL : &fifo->array[len][index];
+}
+
+FIFO_Annotation* FIFO_GetKthNewestAnnotation(FIFO *fifo, int k, int len)
+{
+    int index = FIFO_KthNewestIndex(fifo, k);
+    return index < 0 ? NULL : &fifo->annotations[len][index];
 }
 
 Event* FIFO_GetNewestSequence(FIFO *fifo, int len)
 {
     return FIFO_GetKthNewestSequence(fifo, 0, len);
 }
+
+FIFO_Annotation* FIFO_GetNewestAnnotation(FIFO *fifo, int len)
+{
+    return FIFO_GetKthNewestAnnotation(fifo, 0, len);
+}
+
+int FIFO_AmountSince(FIFO *fifo, long occurrenceTime)
+{
+    //the occurrence time decreases with k, find the first k occurring before
+    int low = 0, high = fifo->itemsAmount;
+    while(low < high)
+    {
+        int k = (low + high) / 2;
+        if(FIFO_GetKthNewestSequence(fifo, k, 0)->occurrenceTime >= occurrenceTime)
+        {
+            low = k + 1;
+        }
+        else
+        {
+            high = k;
+        }
+    }
+    return low;
+}
@@ -5,7 +5,8 @@
 //  First in first out (forgotten) //
 /////////////////////////////////////
 //A FIFO-like structure, that only supports put in and overwrites
-//the oldest task when full
+//the oldest task when full. Events are added in order of occurrence
+//time, which allows to search the FIFO by time.
 
 //References//
 //-----------//
@@ -19,11 +20,20 @@
 
 //Data structure//
 //--------------//
+//Per-entry data for temporal induction, computed when the entry is added
+typedef struct
+{
+    //see Stamp_signature
+    uint64_t stampSignature;
+    //of an operation: the index of the entries which were newest when it was added, its preconditions, -1 for none
+    int precondition;
+} FIFO_Annotation;
 typedef struct
 {
     int itemsAmount;
     int currentIndex;
     Event array[MAX_SEQUENCE_LEN][FIFO_SIZE];
+    FIFO_Annotation annotations[MAX_SEQUENCE_LEN][FIFO_SIZE];
 } FIFO;
 typedef struct
 {
@@ -41,5 +51,11 @@ void FIFO_Add(Event *event, FIFO *fifo);
 Event* FIFO_GetNewestSequence(FIFO *fifo, int len);
 //Get the k-th newest FIFO element
 Event* FIFO_GetKthNewestSequence(FIFO *fifo, int k, int len);
+//Get the annotation of the newest element
+FIFO_Annotation* FIFO_GetNewestAnnotation(FIFO *fifo, int len);
+//Get the annotation of the k-th newest FIFO element
+FIFO_Annotation* FIFO_GetKthNewestAnnotation(FIFO *fifo, int k, int len);
+//Amount of newest elements occurring at or after occurrenceTime, found by binary search
+int FIFO_AmountSince(FIFO *fifo, long occurrenceTime);
 
 #endif
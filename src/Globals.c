@@ -1,6 +1,7 @@
 #include "Globals.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 int OUTPUT = 1;
 void assert(bool b, char* message)
@@ -12,3 +13,10 @@ void assert(bool b, char* message)
         exit(1);
     }
 }
+
+long Globals_Nanoseconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
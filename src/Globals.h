@@ -10,10 +10,19 @@ extern int OUTPUT;
 
 #define IN_DEBUG(x) {if(DEBUG){ x } }
 #define IN_OUTPUT(x) {if(OUTPUT){ x } }
+//A lean build (-DMSC_LEAN, LEAN=1 ./build.sh) doesn't store the debug names of concepts, events and implications,
+//so learning formats and copies no strings, and the names are derived from the concept and operation ids when printed
+#ifdef MSC_LEAN
+#define IN_NAMES(x)
+#else
+#define IN_NAMES(x) { x }
+#endif
 
 #include <stdbool.h>
 
 void assert(bool b, char* message);
+//Monotonic clock for timing runs and phases
+long Globals_Nanoseconds(void);
 
 #define MIN(a, b) (((a) < (b)) ? (a) : (b))
 #define MAX(a, b) (((a) > (b)) ? (a) : (b))
@@ -0,0 +1,231 @@
+#include "Graph.h"
+
+long graph_skipped = 0;
+
+//the copy the writer works on, only touched by the reasoner while no writer runs
+static struct
+{
+    long time;
+    int format;
+    char path[GRAPH_PATH_LEN];
+    int termsAmount;
+    char names[TERMS_MAX][TERMS_LEN+1];
+    Term operations[OPERATIONS_MAX];
+    int edgesAmount;
+    int edgesCapacity;
+    Graph_Edge *edges;
+} graph_copy;
+
+static pthread_t graph_writer;
+static bool graph_writing = false;
+//set by the writer when it is done, so a new export doesn't wait for it
+static bool graph_done = false;
+static bool graph_written = true;
+
+int Graph_Format(const char *path)
+{
+    const char *dot = strrchr(path, '.');
+    return dot != NULL && (!strcmp(dot, ".json") || !strcmp(dot, ".jsonl")) ? GRAPH_JSON : GRAPH_DOT;
+}
+
+//the valid implications of all precondition tables, false if there is no memory for them
+static bool Graph_Copy(long time)
+{
+    int amount = 0;
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi=0; opi<OPERATIONS_MAX; opi++)
+        {
+            amount += c->precondition_beliefs[opi].itemsAmount;
+        }
+    }
+    if(amount > graph_copy.edgesCapacity)
+    {
+        Graph_Edge *edges = realloc(graph_copy.edges, amount * sizeof(Graph_Edge));
+        if(edges == NULL)
+        {
+            return false;
+        }
+        graph_copy.edges = edges;
+        graph_copy.edgesCapacity = amount;
+    }
+    graph_copy.edgesAmount = 0;
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi=0; opi<OPERATIONS_MAX; opi++)
+        {
+            Table *table = &c->precondition_beliefs[opi];
+            for(int j=0; j<table->itemsAmount; j++)
+            {
+                Implication *imp = &table->array[j];
+                if(Memory_ImplicationValid(imp))
+                {
+                    graph_copy.edges[graph_copy.edgesAmount++] = (Graph_Edge) { .precondition = imp->term, .operationID = opi,
+                                                                                 .postcondition = c->term, .truth = imp->truth,
+                                                                                 .offset = imp->occurrenceTimeOffset };
+                }
+            }
+        }
+    }
+    //the names are copied too, as a reset lets them be replaced
+    graph_copy.termsAmount = term_index;
+    for(int i=0; i<term_index; i++)
+    {
+        strncpy(graph_copy.names[i], terms[i], TERMS_LEN);
+        graph_copy.names[i][TERMS_LEN] = 0;
+    }
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        graph_copy.operations[i] = Memory_OperationRegistered(i) ? operations[i].term : (Term) {0};
+    }
+    graph_copy.time = time;
+    return true;
+}
+
+//a name within quotes, escaped as both DOT and JSON need it
+static void Graph_PrintName(FILE *out, const char *name)
+{
+    for(; *name != 0; name++)
+    {
+        if(*name == '"' || *name == '\\')
+        {
+            fputc('\\', out);
+            fputc(*name, out);
+        }
+        else if((unsigned char) *name < ' ')
+        {
+            fprintf(out, "\\u%04x", (unsigned char) *name);
+        }
+        else
+        {
+            fputc(*name, out);
+        }
+    }
+}
+
+//an atom of a term as in the shell, by the copied names
+static void Graph_PrintAtom(FILE *out, int number)
+{
+    Graph_PrintName(out, number <= graph_copy.termsAmount ? graph_copy.names[number-1] : "?");
+}
+
+static void Graph_PrintOperation(FILE *out, int operationID)
+{
+    Term *op = &graph_copy.operations[operationID-1];
+    if(op->terms[0] != 0)
+    {
+        Term_Format(out, op, Graph_PrintAtom);
+    }
+    else
+    {
+        fprintf(out, "^op%d", operationID);
+    }
+}
+
+static void Graph_PrintDOT(FILE *out)
+{
+    fprintf(out, "digraph msc {\n    label=\"time=%ld\";\n", graph_copy.time);
+    for(int i=0; i<graph_copy.edgesAmount; i++)
+    {
+        Graph_Edge *edge = &graph_copy.edges[i];
+        fputs("    \"", out);
+        Term_Format(out, &edge->precondition, Graph_PrintAtom);
+        fputs("\" -> \"", out);
+        Term_Format(out, &edge->postcondition, Graph_PrintAtom);
+        fputs("\" [label=\"", out);
+        if(edge->operationID > 0)
+        {
+            Graph_PrintOperation(out, edge->operationID);
+            fputc(' ', out);
+        }
+        fprintf(out, "+%ld %%%f;%f%%\"];\n", edge->offset, edge->truth.frequency, edge->truth.confidence);
+    }
+    fputs("}\n", out);
+}
+
+static void Graph_PrintJSON(FILE *out)
+{
+    for(int i=0; i<graph_copy.edgesAmount; i++)
+    {
+        Graph_Edge *edge = &graph_copy.edges[i];
+        fprintf(out, "{\"time\":%ld,\"precondition\":\"", graph_copy.time);
+        Term_Format(out, &edge->precondition, Graph_PrintAtom);
+        fputs("\",\"operation\":", out);
+        if(edge->operationID > 0)
+        {
+            fputc('"', out);
+            Graph_PrintOperation(out, edge->operationID);
+            fputc('"', out);
+        }
+        else
+        {
+            fputs("null", out);
+        }
+        fputs(",\"postcondition\":\"", out);
+        Term_Format(out, &edge->postcondition, Graph_PrintAtom);
+        fprintf(out, "\",\"offset\":%ld,\"frequency\":%f,\"confidence\":%f}\n", edge->offset, edge->truth.frequency, edge->truth.confidence);
+    }
+}
+
+static void *Graph_Writer(void *unused)
+{
+    (void) unused;
+    char temporary[GRAPH_PATH_LEN+4];
+    sprintf(temporary, "%s.tmp", graph_copy.path);
+    FILE *out = fopen(temporary, "w");
+    bool written = out != NULL;
+    if(written)
+    {
+        if(graph_copy.format == GRAPH_JSON)
+        {
+            Graph_PrintJSON(out);
+        }
+        else
+        {
+            Graph_PrintDOT(out);
+        }
+        bool failed = ferror(out);
+        written = fclose(out) == 0 && !failed && rename(temporary, graph_copy.path) == 0;
+        if(!written)
+        {
+            remove(temporary);
+        }
+    }
+    graph_written = written;
+    __atomic_store_n(&graph_done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+bool Graph_Export(const char *path, int format, long time)
+{
+    if(graph_writing)
+    {
+        if(!__atomic_load_n(&graph_done, __ATOMIC_ACQUIRE))
+        {
+            graph_skipped++;
+            return false;
+        }
+        Graph_Wait();
+    }
+    if(strlen(path) >= GRAPH_PATH_LEN || !Graph_Copy(time))
+    {
+        return false;
+    }
+    strcpy(graph_copy.path, path);
+    graph_copy.format = format;
+    graph_done = false;
+    graph_writing = pthread_create(&graph_writer, NULL, Graph_Writer, NULL) == 0;
+    return graph_writing;
+}
+
+bool Graph_Wait(void)
+{
+    if(graph_writing)
+    {
+        pthread_join(graph_writer, NULL);
+        graph_writing = false;
+    }
+    return graph_written;
+}
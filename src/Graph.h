@@ -0,0 +1,51 @@
+#ifndef H_GRAPH
+#define H_GRAPH
+
+///////////////////
+//  MSC Graph    //
+///////////////////
+//Export of the learned implication graph <(&/,precondition,^op,+offset) =/> postcondition>
+//while the reasoner runs. At a cycle boundary the valid implications of all precondition
+//tables are copied as edges, together with the names of the terms and operations, which
+//is all the reasoner waits for. A background thread then writes the copy as a DOT digraph
+//or as JSON lines into a temporary file, which is renamed to the path once it is complete,
+//so a reader never sees a partial export.
+
+//References//
+//-----------//
+#include <stdio.h>
+#include <pthread.h>
+#include "Memory.h"
+#include "Encode.h"
+
+//Parameters//
+//----------//
+#define GRAPH_DOT 0
+#define GRAPH_JSON 1
+#define GRAPH_PATH_LEN 1024
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    Term precondition;
+    //0 for an implication without operation
+    int operationID;
+    Term postcondition;
+    Truth truth;
+    long offset;
+} Graph_Edge;
+//exports which weren't started because the previous one was still being written
+extern long graph_skipped;
+
+//Methods//
+//-------//
+//GRAPH_JSON for a path ending with .json or .jsonl, GRAPH_DOT otherwise
+int Graph_Format(const char *path);
+//Copy the graph at the time and start writing it to the path in the background, false if the previous
+//export is still being written or the thread can't be started
+bool Graph_Export(const char *path, int format, long time);
+//Wait until the export being written is complete, false if it couldn't be written
+bool Graph_Wait(void);
+
+#endif
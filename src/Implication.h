@@ -20,11 +20,14 @@ typedef struct {
     Stamp stamp;
     //for deciding occurrence time of conclusion:
     long occurrenceTimeOffset;
-    //for efficient spike propagation:
-    void *sourceConcept;
+    //for efficient spike propagation, the slot of the source concept in concept storage,
+    //which unlike a pointer stays valid wherever the storage is mapped:
+    int sourceConcept;
     Term sourceConceptTerm; //to check whether it's still the same
     //Term_HASH_TYPE sourceConceptTermHash;
+#ifndef MSC_LEAN
     char debug[100]; //++ DEBUG
+#endif
 } Implication;
 
 //Methods//
@@ -57,7 +57,7 @@ Implication Inference_ImplicationRevision(Implication *a, Implication *b)
                                       .truth = Truth_Revision(a->truth, b->truth),
                                       .stamp = conclusionStamp, 
                                       .occurrenceTimeOffset = occurrenceTimeOffsetAvg };
-    strcpy(ret.debug, a->debug);
+    IN_NAMES( strcpy(ret.debug, a->debug); )
     return ret;
 }
 
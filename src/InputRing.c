@@ -0,0 +1,53 @@
+#include "InputRing.h"
+
+void InputRing_RESET(InputRing *ring)
+{
+    Ring_RESET(&ring->ring);
+    for(int i=0; i<INPUT_RING_SIZE; i++)
+    {
+        ring->array[i] = (InputRing_Entry) {0};
+    }
+}
+
+InputRing_Entry *InputRing_Reserve(InputRing *ring)
+{
+    int slot = Ring_Reserve(&ring->ring, INPUT_RING_SIZE);
+    return slot < 0 ? NULL : &ring->array[slot];
+}
+
+void InputRing_Commit(InputRing *ring)
+{
+    Ring_Commit(&ring->ring);
+}
+
+bool InputRing_Push(InputRing *ring, Term term, char type, Truth truth, int operationID, long timestamp)
+{
+    InputRing_Entry *entry = InputRing_Reserve(ring);
+    if(entry == NULL)
+    {
+        return false;
+    }
+    entry->term = term;
+    entry->type = type;
+    entry->truth = truth;
+    entry->operationID = operationID;
+    entry->timestamp = timestamp;
+    InputRing_Commit(ring);
+    return true;
+}
+
+InputRing_Entry *InputRing_Front(InputRing *ring)
+{
+    int slot = Ring_Front(&ring->ring, INPUT_RING_SIZE);
+    return slot < 0 ? NULL : &ring->array[slot];
+}
+
+void InputRing_Release(InputRing *ring)
+{
+    Ring_Release(&ring->ring);
+}
+
+int InputRing_Size(InputRing *ring)
+{
+    return Ring_Size(&ring->ring);
+}
@@ -0,0 +1,58 @@
+#ifndef H_INPUTRING
+#define H_INPUTRING
+
+///////////////////////////////////////////
+//  Input ring (single producer/consumer) //
+///////////////////////////////////////////
+//A lock-free ring buffer for input events, allowing a sensor thread to
+//hand over events without blocking while the reasoner thread drains
+//them at cycle boundaries. Only one producer and one consumer are supported.
+//The producer has to push terms encoded before it started, as Encode_Term
+//extends the term dictionary without synchronization.
+
+//References//
+//-----------//
+#include <stdbool.h>
+#include "Ring.h"
+#include "Term.h"
+#include "Truth.h"
+
+//Parameters//
+//----------//
+#define INPUT_RING_SIZE 1024 //has to be a power of two
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    Term term;
+    char type;
+    Truth truth;
+    int operationID;
+    //occurrence time requested by the producer, 0 for "as soon as possible"
+    long timestamp;
+} InputRing_Entry;
+typedef struct
+{
+    Ring ring;
+    InputRing_Entry array[INPUT_RING_SIZE];
+} InputRing;
+
+//Methods//
+//-------//
+//Resets the ring, must not be called while producer or consumer are active
+void InputRing_RESET(InputRing *ring);
+//Producer: get the next free slot to fill in place, NULL if the ring is full
+InputRing_Entry *InputRing_Reserve(InputRing *ring);
+//Producer: publish the slot obtained by InputRing_Reserve
+void InputRing_Commit(InputRing *ring);
+//Producer: reserve, fill and commit in one go, false if the ring is full
+bool InputRing_Push(InputRing *ring, Term term, char type, Truth truth, int operationID, long timestamp);
+//Consumer: get the oldest published entry without removing it, NULL if empty
+InputRing_Entry *InputRing_Front(InputRing *ring);
+//Consumer: free the entry obtained by InputRing_Front
+void InputRing_Release(InputRing *ring);
+//Amount of published entries not yet released
+int InputRing_Size(InputRing *ring);
+
+#endif
@@ -0,0 +1,163 @@
+#include "Journal.h"
+
+int JOURNAL_COMPACT_RECORDS = JOURNAL_COMPACT_RECORDS_INITIAL;
+int journal_records = 0;
+
+static FILE *journal_file = NULL;
+static bool journal_failed = false;
+static long journal_time = 0;
+static long journal_written_time = -1;
+
+//the fields a journal can only be read with if they match
+static const int journal_layout[] = { sizeof(Term), sizeof(Implication), sizeof(long), OPERATIONS_MAX };
+
+static bool Journal_Header(FILE *file, bool write, long *baseTime)
+{
+    return Binary_Header(file, write, "MSCJRNL", JOURNAL_VERSION, journal_layout, sizeof(journal_layout) / sizeof(int)) &&
+           TRANSFER(*baseTime);
+}
+
+//only the used part of the stamp and debug name
+static bool Journal_ImplicationFields(FILE *file, bool write, Implication *imp)
+{
+    unsigned char stampSize = 0;
+    for(int i=0; write && i<STAMP_SIZE; i++)
+    {
+        if(imp->stamp.evidentalBase[i] != STAMP_FREE)
+        {
+            stampSize = i+1;
+        }
+    }
+    bool transferred = TRANSFER(imp->term) && TRANSFER(imp->truth) && TRANSFER(imp->occurrenceTimeOffset) &&
+                       TRANSFER(imp->sourceConcept) && TRANSFER(imp->sourceConceptTerm) &&
+                       TRANSFER(stampSize) && stampSize <= STAMP_SIZE &&
+                       (stampSize == 0 || Binary_Transfer(file, write, imp->stamp.evidentalBase, stampSize * sizeof(long)));
+#ifndef MSC_LEAN
+    unsigned char debugLength = write ? strlen(imp->debug) : 0;
+    transferred = transferred && TRANSFER(debugLength) && debugLength < sizeof(imp->debug) &&
+                  (debugLength == 0 || Binary_Transfer(file, write, imp->debug, debugLength));
+#endif
+    return transferred;
+}
+
+static bool Journal_Fields(FILE *file, bool write, Journal_Record *record)
+{
+    switch(record->type)
+    {
+        case JOURNAL_TIME:
+            return TRANSFER(record->time) && TRANSFER(record->base) && TRANSFER(record->stampID);
+        case JOURNAL_CONCEPT:
+            return TRANSFER(record->slot) && TRANSFER(record->id) && TRANSFER(record->generation) &&
+                   TRANSFER(record->evictedGeneration) && TRANSFER(record->term);
+        case JOURNAL_IMPLICATION:
+            return TRANSFER(record->slot) && TRANSFER(record->operationID) && Journal_ImplicationFields(file, write, &record->implication);
+        case JOURNAL_REMOVAL:
+            return TRANSFER(record->slot) && TRANSFER(record->operationID) && TRANSFER(record->index);
+    }
+    return false;
+}
+
+static void Journal_Write(Journal_Record *record)
+{
+    bool write = true;
+    FILE *file = journal_file;
+    //each record is preceded by the time it happened at, if that changed
+    if(journal_written_time != journal_time)
+    {
+        journal_written_time = journal_time;
+        Journal_Record time = { .type = JOURNAL_TIME, .time = journal_time, .base = base, .stampID = stampID };
+        Journal_Write(&time);
+    }
+    if(!TRANSFER(record->type) || !Journal_Fields(file, write, record))
+    {
+        journal_failed = true;
+    }
+    journal_records++;
+}
+
+bool Journal_Open(const char *path, long baseTime)
+{
+    Journal_Close();
+    journal_file = fopen(path, "wb");
+    if(journal_file == NULL)
+    {
+        return false;
+    }
+    journal_failed = false;
+    journal_records = 0;
+    journal_time = baseTime;
+    journal_written_time = -1;
+    journal_failed = !Journal_Header(journal_file, true, &baseTime);
+    return Journal_Flush();
+}
+
+bool Journal_Close(void)
+{
+    if(journal_file == NULL)
+    {
+        return true;
+    }
+    bool written = Journal_Flush();
+    written = fclose(journal_file) == 0 && written;
+    journal_file = NULL;
+    return written;
+}
+
+bool Journal_Flush(void)
+{
+    if(journal_file != NULL && fflush(journal_file) != 0)
+    {
+        journal_failed = true;
+    }
+    return !journal_failed;
+}
+
+bool Journal_Active(void)
+{
+    return journal_file != NULL;
+}
+
+void Journal_Time(long currentTime)
+{
+    journal_time = currentTime;
+}
+
+void Journal_Concept(int slot, Concept *c, long evictedGeneration)
+{
+    if(journal_file != NULL)
+    {
+        Journal_Record record = { .type = JOURNAL_CONCEPT, .slot = slot, .id = c->id, .generation = c->generation,
+                                  .evictedGeneration = evictedGeneration, .term = c->term };
+        Journal_Write(&record);
+    }
+}
+
+void Journal_Implication(int slot, int operationID, Implication *imp)
+{
+    if(journal_file != NULL)
+    {
+        Journal_Record record = { .type = JOURNAL_IMPLICATION, .slot = slot, .operationID = operationID, .implication = *imp };
+        Journal_Write(&record);
+    }
+}
+
+void Journal_Removal(int slot, int operationID, int index)
+{
+    if(journal_file != NULL)
+    {
+        Journal_Record record = { .type = JOURNAL_REMOVAL, .slot = slot, .operationID = operationID, .index = index };
+        Journal_Write(&record);
+    }
+}
+
+bool Journal_ReadHeader(FILE *file, long *baseTime)
+{
+    return Journal_Header(file, false, baseTime);
+}
+
+bool Journal_ReadRecord(FILE *file, Journal_Record *record)
+{
+    bool write = false;
+    *record = (Journal_Record) {0};
+    return TRANSFER(record->type) && Journal_Fields(file, write, record);
+}
@@ -0,0 +1,77 @@
+#ifndef H_JOURNAL
+#define H_JOURNAL
+
+///////////////////////
+//  MSC Journal      //
+///////////////////////
+//Append-only record of the changes to the knowledge since a base snapshot: concepts
+//entering memory (evicting the one in their slot), the implications added or revised
+//in the tables and the implications removed from them, each with the slot of its
+//concept. Applied to the base snapshot in order, the records reproduce the concepts
+//and tables, so a checkpoint only costs the changes since the last one.
+
+//References//
+//-----------//
+#include "Concept.h"
+#include "Binary.h"
+
+//Parameters//
+//----------//
+#define JOURNAL_VERSION 3
+//the journal is compacted into a new base snapshot once it holds this many records
+#define JOURNAL_COMPACT_RECORDS_INITIAL 4096
+extern int JOURNAL_COMPACT_RECORDS;
+
+//Data structure//
+//--------------//
+#define JOURNAL_TIME 1
+#define JOURNAL_CONCEPT 2
+#define JOURNAL_IMPLICATION 3
+#define JOURNAL_REMOVAL 4
+typedef struct
+{
+    char type;
+    //JOURNAL_TIME: the time and stamp counters of the following records
+    long time;
+    long base;
+    int stampID;
+    //the concept slot and table of the other records
+    int slot;
+    int operationID;
+    //JOURNAL_CONCEPT: the new concept, and the generation of the concept it evicted, 0 if the slot was free
+    int id;
+    long generation;
+    long evictedGeneration;
+    Term term;
+    //JOURNAL_IMPLICATION: the implication as it was put into the table
+    Implication implication;
+    //JOURNAL_REMOVAL: the index of the removed implication
+    int index;
+} Journal_Record;
+//records written since the journal was opened
+extern int journal_records;
+
+//Methods//
+//-------//
+//Start an empty journal of the changes after the base snapshot taken at baseTime, false if it can't be written
+bool Journal_Open(const char *path, long baseTime);
+//Flush and close the journal, false if a record couldn't be written
+bool Journal_Close(void);
+//Write the buffered records to the file, false if a record couldn't be written
+bool Journal_Flush(void);
+//Whether changes are journaled
+bool Journal_Active(void);
+//The time of the following changes
+void Journal_Time(long currentTime);
+//The concept entered memory in the slot, evicting the concept of evictedGeneration
+void Journal_Concept(int slot, Concept *c, long evictedGeneration);
+//The implication was put into the table of the concept in the slot
+void Journal_Implication(int slot, int operationID, Implication *imp);
+//The implication at index was removed from the table of the concept in the slot
+void Journal_Removal(int slot, int operationID, int index);
+//Whether the file continues with a journal of this version and layout, returning the time of its base snapshot
+bool Journal_ReadHeader(FILE *file, long *baseTime);
+//The next record, false at the end of the journal or at a record cut short
+bool Journal_ReadRecord(FILE *file, Journal_Record *record);
+
+#endif
@@ -1,60 +1,216 @@
 #include "MSC.h"
 
 long currentTime = 1;
-bool MSC_InputLoggingEnabled = true;
+static InputRing MSC_InputRing;
+static bool MSC_Draining = false;
+static char MSC_SnapshotPath[1024];
+static char MSC_JournalPath[1024];
+//the records after which a failed compaction is tried again, rather than at every cycle
+static long MSC_CheckpointBackoff = 0;
+long msc_checkpoints_failed = 0;
+//inputs and cycles within a cycle or input follow from it, so only those outside are traced
+static int MSC_TraceDepth = 0;
+//the periodic graph export, kept across resets like the other host settings
+static char MSC_GraphPath[GRAPH_PATH_LEN];
+static int MSC_GraphFormat = GRAPH_DOT;
+static long MSC_GraphInterval = 0;
+//and the periodic report of the stats
+static long MSC_StatsInterval = 0;
 
 void MSC_INIT(void)
 {
+    MSC_CloseJournal(); //the journal continues the previous memory
+    Trace_Write(&(Trace_Record) { .type = TRACE_INIT });
+    Memory_UnmapConcepts(currentTime); //a mapped store keeps its concepts, the memory continuing empty in process memory
     Memory_INIT(); //clear data structures
     Event_INIT(); //reset base id counter
+    InputRing_RESET(&MSC_InputRing); //drop inputs queued for the previous run
+    Decision_INIT(); //drop queued actions
+    Cycle_INIT(); //drop cached plans
     currentTime = 1; //reset time
 }
 
 void MSC_SetInputLogging(bool enabled)
 {
-    MSC_InputLoggingEnabled = enabled;
+    EVENTLOG_LEVEL[EVENTLOG_INPUT] = enabled ? EVENTLOG_PRINT : EVENTLOG_OFF;
+}
+
+static Event MSC_AddEvent(Term term, char type, Truth truth, int operationID);
+
+//a single cycle, with operator feedback of a deferred execution entering at its boundary
+static void MSC_Cycle(void)
+{
+    if(MSC_TraceDepth == 0)
+    {
+        Trace_Cycle();
+    }
+    MSC_TraceDepth++;
+    Decision feedback;
+    if(Decision_TakeFeedback(&feedback))
+    {
+        MSC_AddEvent(feedback.op.term, EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, feedback.operationID);
+    }
+    IN_DEBUG( puts("\nNew system cycle:\n----------"); )
+    Cycle_Perform(currentTime);
+    currentTime++;
+    Journal_Time(currentTime);
+    if(MSC_GraphInterval > 0 && currentTime % MSC_GraphInterval == 0)
+    {
+        MSC_ExportGraph(MSC_GraphPath, MSC_GraphFormat);
+    }
+    if(MSC_StatsInterval > 0 && currentTime % MSC_StatsInterval == 0)
+    {
+        fprintf(stderr, "stats at time %ld: ", currentTime);
+        Profile_Print(&profile_stats, stderr);
+    }
+    if(Journal_Active() && journal_records >= JOURNAL_COMPACT_RECORDS + MSC_CheckpointBackoff && !MSC_Checkpoint())
+    {
+        MSC_CheckpointBackoff = journal_records;
+        msc_checkpoints_failed++;
+        fprintf(stderr, "Error: checkpoint into %s failed at time %ld\n", MSC_SnapshotPath, currentTime);
+    }
+    if(EXECUTION_MODE == EXECUTION_DEFERRED && !Decision_BatchDispatching())
+    {
+        Decision_DispatchActions();
+    }
+    MSC_TraceDepth--;
 }
 
 void MSC_Cycles(int cycles)
 {
     for(int i=0; i<cycles; i++)
     {
-        IN_DEBUG( puts("\nNew system cycle:\n----------"); )
-        Cycle_Perform(currentTime);
-        currentTime++;
+        MSC_DrainInputs();
+        MSC_Cycle();
+    }
+    Journal_Flush();
+    //a batch dispatcher gets the decisions of the whole step
+    if(EXECUTION_MODE == EXECUTION_DEFERRED && Decision_BatchDispatching())
+    {
+        Decision_DispatchActions();
     }
 }
 
-Event MSC_AddInput(Term term, char type, Truth truth, int operationID)
+//the cycles the system stays idle for: without feedback to inject, action to dispatch, input to add and event to process
+static long MSC_IdleCycles(void)
 {
-    Event ev = Event_InputEvent(term, type, truth, currentTime);
-    int closest_concept_i=0;
-    if(Memory_FindConceptByTerm(&term, /*Term_Hash(&term),*/ &closest_concept_i))
+    bool dispatching = EXECUTION_MODE == EXECUTION_DEFERRED && !Decision_BatchDispatching();
+    if(Decision_FeedbackPending() || (dispatching && Decision_ActionsPending()) || !Cycle_Idle())
+    {
+        return 0;
+    }
+    InputRing_Entry *entry = InputRing_Front(&MSC_InputRing);
+    return entry == NULL ? LONG_MAX : MAX(0, entry->timestamp - currentTime);
+}
+
+//the cycles up to and including the next one at whose end a periodic export or report is due, LONG_MAX for none
+static long MSC_HookCycles(void)
+{
+    long cycles = LONG_MAX;
+    if(MSC_GraphInterval > 0)
+    {
+        cycles = MIN(cycles, MSC_GraphInterval - currentTime % MSC_GraphInterval);
+    }
+    if(MSC_StatsInterval > 0)
     {
-        Concept *c = concepts.items[closest_concept_i].address;
-        if(strlen(c->debug) == 0)
+        cycles = MIN(cycles, MSC_StatsInterval - currentTime % MSC_StatsInterval);
+    }
+    return cycles;
+}
+
+void MSC_AdvanceTime(int cycles)
+{
+    //an idle cycle only re-sorts the concepts, which permutes the ones of equal priority,
+    //so once their order repeats, all the whole periods left can be skipped
+    static Item order[CONCEPTS_MAX];
+    int observed = -1; //idle cycles since the order was recorded
+    for(int i=0; i<cycles; i++)
+    {
+        long idle = MSC_IdleCycles();
+        if(idle == 0)
         {
-            char debug[20];
-            //assign index as name to event and concept since concept has no name yet
-            sprintf(debug, "%d", c->id);
-            strcpy(ev.debug, debug);
-            strcpy(c->debug, debug);
+            observed = -1;
         }
-        else
+        else if(observed < 0)
         {
-            //name event according to concept
-            strcpy(ev.debug, c->debug);
+            memcpy(order, concepts.items, concepts.itemsAmount * sizeof(Item));
+            observed = 0;
         }
-        char* st = type == EVENT_TYPE_BELIEF ? "." : "!";
-        if(MSC_InputLoggingEnabled)
+        else if(memcmp(order, concepts.items, concepts.itemsAmount * sizeof(Item)) == 0)
         {
-            printf("Input: %s%s :|: %%%f;%f%%\n", c->debug, st, truth.frequency, truth.confidence);
+            //the cycle a periodic export or report is due at is performed
+            long skip = (MIN(MIN(idle, cycles - i), MSC_HookCycles() - 1) / observed) * observed;
+            currentTime += skip;
+            Journal_Time(currentTime);
+            Trace_Write(&(Trace_Record) { .type = TRACE_SKIP, .cycles = skip });
+            i += skip;
+            observed = 0;
+            if(i >= cycles)
+            {
+                break;
+            }
         }
+        MSC_DrainInputs();
+        MSC_Cycle();
+        if(observed >= 0)
+        {
+            observed++;
+        }
+    }
+    //a batch dispatcher gets the decisions of the whole step
+    if(EXECUTION_MODE == EXECUTION_DEFERRED && Decision_BatchDispatching())
+    {
+        Decision_DispatchActions();
+    }
+}
+
+static Event MSC_AddEvent(Term term, char type, Truth truth, int operationID)
+{
+    Event ev = Event_InputEvent(term, type, truth, currentTime);
+    //resolving here caches the concept handle in the event for the later stages
+    Concept *c = Memory_ResolveConcept(&ev);
+    if(c != NULL)
+    {
+        IN_NAMES
+        (
+            if(strlen(c->debug) == 0)
+            {
+                char debug[20];
+                //assign index as name to event and concept since concept has no name yet
+                sprintf(debug, "%d", c->id);
+                strcpy(ev.debug, debug);
+                strcpy(c->debug, debug);
+            }
+            else
+            {
+                //name event according to concept
+                strcpy(ev.debug, c->debug);
+            }
+        )
+        EventLog_Input(c->id, &term, type, truth, operationID, currentTime);
     }
     ev.operationID = operationID;
     Memory_addEvent(&ev);
     IN_OUTPUT( fputs("INPUT ", stdout); Event_Print(&ev); )
+    return ev;
+}
+
+Event MSC_AddInput(Term term, char type, Truth truth, int operationID)
+{
+    if(MSC_TraceDepth == 0)
+    {
+        Trace_Write(&(Trace_Record) { .type = TRACE_INPUT, .term = term, .eventType = type, .truth = truth,
+                                      .operationID = operationID, .iterations = PROPAGATION_ITERATIONS });
+    }
+    MSC_TraceDepth++;
+    //pending operator feedback has to precede the input in time
+    while(Decision_FeedbackPending())
+    {
+        MSC_Cycle();
+    }
+    Event ev = MSC_AddEvent(term, type, truth, operationID);
     MSC_Cycles(1);
+    MSC_TraceDepth--;
     return ev;
 }
 
@@ -69,7 +225,270 @@ Event MSC_AddInputGoal(Term term)
     return MSC_AddInput(term, EVENT_TYPE_GOAL, MSC_DEFAULT_TRUTH, 0);
 }
 
+Event MSC_AddInputGoalWithBudget(Term term, int iterations)
+{
+    int budget = PROPAGATION_ITERATIONS;
+    PROPAGATION_ITERATIONS = iterations;
+    Event ret = MSC_AddInputGoal(term);
+    PROPAGATION_ITERATIONS = budget;
+    return ret;
+}
+
 void MSC_AddOperation(Term term, Action procedure)
 {
+    Trace_Write(&(Trace_Record) { .type = TRACE_OPERATION, .term = term });
     Memory_addOperation((Operation) {.term = term, .action = procedure});
 }
+
+void MSC_AddOperationWithContext(Term term, ContextAction procedure, void *user)
+{
+    Trace_Write(&(Trace_Record) { .type = TRACE_OPERATION, .term = term });
+    Memory_addOperation((Operation) {.term = term, .contextAction = procedure, .user = user});
+}
+
+bool MSC_PushInput(Term term, char type, Truth truth, int operationID, long timestamp)
+{
+    return InputRing_Push(&MSC_InputRing, term, type, truth, operationID, timestamp);
+}
+
+int MSC_DrainInputs(void)
+{
+    //MSC_AddInput runs a cycle itself, which would drain again
+    if(MSC_Draining)
+    {
+        return 0;
+    }
+    MSC_Draining = true;
+    int added = 0;
+    InputRing_Entry *entry;
+    while((entry = InputRing_Front(&MSC_InputRing)) != NULL && entry->timestamp <= currentTime)
+    {
+        //the slot stays owned by the consumer until released, so no copy is needed
+        MSC_AddInput(entry->term, entry->type, entry->truth, entry->operationID);
+        InputRing_Release(&MSC_InputRing);
+        added++;
+    }
+    MSC_Draining = false;
+    return added;
+}
+
+bool MSC_Save(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if(file == NULL)
+    {
+        return false;
+    }
+    bool saved = Snapshot_Write(file, currentTime);
+    return fclose(file) == 0 && saved;
+}
+
+bool MSC_ExportGraph(const char *path, int format)
+{
+    return Graph_Export(path, format, currentTime);
+}
+
+void MSC_ExportGraphEvery(const char *path, int format, long cycles)
+{
+    MSC_GraphInterval = strlen(path) < GRAPH_PATH_LEN ? cycles : 0;
+    if(MSC_GraphInterval > 0)
+    {
+        strcpy(MSC_GraphPath, path);
+        MSC_GraphFormat = format;
+    }
+}
+
+void MSC_GetStats(Profile_Stats *stats)
+{
+    *stats = profile_stats;
+}
+
+void MSC_ResetStats(void)
+{
+    profile_stats = (Profile_Stats) {0};
+}
+
+void MSC_ReportStatsEvery(long cycles)
+{
+    MSC_StatsInterval = cycles;
+}
+
+bool MSC_Load(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return false;
+    }
+    bool loaded = false;
+    if(Snapshot_ReadHeader(file))
+    {
+        loaded = Snapshot_Read(file, &currentTime);
+        if(loaded)
+        {
+            MSC_CloseJournal(); //the journal continues the previous memory
+            Memory_IndexConcepts(); //the implications and spikes of the loaded concepts
+            Cycle_INIT(); //drop plans of the previous memory
+        }
+    }
+    fclose(file);
+    return loaded;
+}
+
+//the anticipations and plans point to concepts of the storage which was replaced
+bool MSC_MapConcepts(const char *path)
+{
+    bool mapped = Memory_MapConcepts(path, &currentTime);
+    Anticipation_RESET(&anticipations, currentTime);
+    Cycle_INIT();
+    return mapped;
+}
+
+void MSC_UnmapConcepts(void)
+{
+    Memory_UnmapConcepts(currentTime);
+    Anticipation_RESET(&anticipations, currentTime);
+    Cycle_INIT();
+}
+
+bool MSC_OpenJournal(const char *snapshotPath, const char *journalPath)
+{
+    MSC_CloseJournal();
+    if(strlen(snapshotPath) >= sizeof(MSC_SnapshotPath) || strlen(journalPath) >= sizeof(MSC_JournalPath))
+    {
+        return false;
+    }
+    strcpy(MSC_SnapshotPath, snapshotPath);
+    strcpy(MSC_JournalPath, journalPath);
+    if(!MSC_Checkpoint())
+    {
+        MSC_JournalPath[0] = 0;
+        return false;
+    }
+    return true;
+}
+
+bool MSC_Checkpoint(void)
+{
+    if(MSC_JournalPath[0] == 0)
+    {
+        return false;
+    }
+    //the base is replaced as a whole, and until the journal starts over, the previous one doesn't match it
+    char temporary[sizeof(MSC_SnapshotPath) + 4];
+    sprintf(temporary, "%s.tmp", MSC_SnapshotPath);
+    if(!MSC_Save(temporary) || rename(temporary, MSC_SnapshotPath) != 0 || !Journal_Open(MSC_JournalPath, currentTime))
+    {
+        return false;
+    }
+    MSC_CheckpointBackoff = 0;
+    return true;
+}
+
+bool MSC_CloseJournal(void)
+{
+    MSC_JournalPath[0] = 0;
+    return Journal_Close();
+}
+
+bool MSC_Recover(const char *snapshotPath, const char *journalPath)
+{
+    if(!MSC_Load(snapshotPath))
+    {
+        return false;
+    }
+    //without a journal of this base, as after a crash within a checkpoint, the base is the latest state
+    long baseTime;
+    FILE *file = fopen(journalPath, "rb");
+    if(file == NULL)
+    {
+        return true;
+    }
+    if(!Journal_ReadHeader(file, &baseTime) || baseTime != currentTime)
+    {
+        fclose(file);
+        return true;
+    }
+    //a record cut short by a crash ends the journal
+    int changes = 0;
+    bool applied = true;
+    Journal_Record record;
+    while(applied && Journal_ReadRecord(file, &record))
+    {
+        applied = Memory_ApplyJournalRecord(&record);
+        if(record.type == JOURNAL_TIME)
+        {
+            currentTime = MAX(currentTime, record.time + 1);
+        }
+        changes++;
+    }
+    fclose(file);
+    if(!applied)
+    {
+        MSC_INIT();
+        return false;
+    }
+    //the short-term state of the base predates the changes, and only the knowledge is journaled
+    if(changes > 0)
+    {
+        FIFO_RESET(&belief_events);
+        FIFO_RESET(&goal_events);
+        for(int i=0; i<concepts.itemsAmount; i++)
+        {
+            Concept *c = concepts.items[i].address;
+            c->belief_spike = c->incoming_goal_spike = c->goal_spike = (Event) {0};
+        }
+        Anticipation_RESET(&anticipations, currentTime);
+        Cycle_INIT();
+    }
+    return true;
+}
+
+//operations of a replayed trace only need to be decided for
+static void MSC_ReplayOperation(void) { }
+
+bool MSC_Replay(const char *path)
+{
+    if(!Trace_OpenReplay(path))
+    {
+        return false;
+    }
+    MSC_INIT();
+    Trace_Record record;
+    while(!trace_diverged && Trace_Next(&record))
+    {
+        switch(record.type)
+        {
+            case TRACE_INIT:
+                MSC_INIT();
+                break;
+            case TRACE_OPERATION:
+                MSC_AddOperation(record.term, MSC_ReplayOperation);
+                break;
+            case TRACE_INPUT:
+            {
+                int iterations = PROPAGATION_ITERATIONS;
+                PROPAGATION_ITERATIONS = record.iterations;
+                MSC_AddInput(record.term, record.eventType, record.truth, record.operationID);
+                PROPAGATION_ITERATIONS = iterations;
+                break;
+            }
+            case TRACE_CYCLES:
+                for(long i=0; i<record.cycles; i++)
+                {
+                    MSC_Cycle();
+                }
+                break;
+            case TRACE_SKIP:
+                currentTime += record.cycles;
+                Journal_Time(currentTime);
+                break;
+            default:
+                //a draw or decision the reasoner didn't make
+                trace_diverged = true;
+                break;
+        }
+    }
+    Trace_CloseReplay();
+    return !trace_diverged;
+}
@@ -7,7 +7,12 @@
 
 //References//
 //-----------//
+#include <limits.h>
 #include "Cycle.h"
+#include "InputRing.h"
+#include "Snapshot.h"
+#include "Graph.h"
+#include "Profile.h"
 
 //Parameters//
 //----------//
@@ -15,10 +20,13 @@
 #define MSC_DEFAULT_CONFIDENCE 0.9
 #define MSC_DEFAULT_TRUTH ((Truth) { .frequency = MSC_DEFAULT_FREQUENCY, .confidence = MSC_DEFAULT_CONFIDENCE })
 extern long currentTime;
+//compactions of the journal which failed (see MSC_OpenJournal)
+extern long msc_checkpoints_failed;
 
 //Callback function types//
 //-----------------------//
 //typedef void (*Action)(void);     //already defined in Memory
+//typedef void (*ContextAction)(void *user, double desire);     //already defined in Memory
 
 //Methods//
 //-------//
@@ -27,11 +35,60 @@ void MSC_INIT(void);
 void MSC_SetInputLogging(bool enabled);
 //Run the system for a certain amount of cycles
 void MSC_Cycles(int cycles);
+//Same as MSC_Cycles, but once the system is idle the remaining cycles are skipped by advancing the time directly
+void MSC_AdvanceTime(int cycles);
 //Add input
 Event MSC_AddInput(Term term, char type, Truth truth, int operationID);
 Event MSC_AddInputBelief(Term term, int operationID);
 Event MSC_AddInputGoal(Term term);
+//Add a goal which propagates for at most the given amount of iterations instead of PROPAGATION_ITERATIONS
+Event MSC_AddInputGoalWithBudget(Term term, int iterations);
 //Add an operation
 void MSC_AddOperation(Term term, Action procedure);
+//Add an operation whose callback receives user context and the decision's desire
+void MSC_AddOperationWithContext(Term term, ContextAction procedure, void *user);
+//Queue input from a (single) sensor thread, without blocking, false if the queue is full.
+//A timestamp of 0 means the event occurs at the next cycle boundary, otherwise not before that time.
+//The terms have to be encoded beforehand, as Encode_Term isn't thread-safe
+bool MSC_PushInput(Term term, char type, Truth truth, int operationID, long timestamp);
+//Add the queued inputs which are due, each taking a cycle like MSC_AddInput, returns the amount added
+int MSC_DrainInputs(void);
+//Save the state of the reasoner to a file (see Snapshot.h), false if it couldn't be written
+bool MSC_Save(const char *path);
+//Continue from a state saved by MSC_Save, keeping the callbacks of the registered operations of the same name,
+//and the queued inputs and actions. A journal being written is closed, as it continues the previous memory.
+//False if the file isn't a snapshot of this build, ends early or is corrupt, leaving the state unchanged.
+bool MSC_Load(const char *path);
+//Keep the concepts in a file instead of process memory (see Memory_MapConcepts), to be called right after MSC_INIT.
+//The store stays as it is when it's replaced, unmapped or detached by MSC_INIT, which continues in process memory.
+bool MSC_MapConcepts(const char *path);
+//Sync and unmap the concept store, leaving an empty memory in process memory again
+void MSC_UnmapConcepts(void);
+//Export the learned implication graph as GRAPH_DOT or GRAPH_JSON (see Graph.h), written in the background from a copy
+//taken now. False if the previous export is still being written, in which case none is started.
+bool MSC_ExportGraph(const char *path, int format);
+//Export the graph to the path whenever the time reaches a multiple of the cycles, 0 to stop
+void MSC_ExportGraphEvery(const char *path, int format, long cycles);
+//Copy what the cycles took since the last reset while PROFILING (see Profile.h)
+void MSC_GetStats(Profile_Stats *stats);
+void MSC_ResetStats(void);
+//Print the stats to stderr whenever the time reaches a multiple of the cycles, 0 to stop
+void MSC_ReportStatsEvery(long cycles);
+//Checkpoint the state into a base snapshot and journal the changes to the knowledge after it (see Journal.h),
+//compacting them into a new base snapshot once there are JOURNAL_COMPACT_RECORDS. False if a file can't be written.
+//A failed compaction is reported to stderr, counted in msc_checkpoints_failed, and retried after as many records again.
+bool MSC_OpenJournal(const char *snapshotPath, const char *journalPath);
+//Compact the journal into a new base snapshot now, false if no journal is open or a file can't be written
+bool MSC_Checkpoint(void);
+//Stop journaling, the files staying valid for MSC_Recover. False if a record couldn't be written
+bool MSC_CloseJournal(void);
+//Load the base snapshot and apply the journaled changes, the learned knowledge ending as when the last complete
+//record was written. The events, spikes and anticipations of the base are dropped if there were changes after it.
+//False as by MSC_Load, or if the journal doesn't fit the snapshot, then leaving the system reset as by MSC_INIT.
+bool MSC_Recover(const char *snapshotPath, const char *journalPath);
+//Run the reasoner through a trace recorded between Trace_Start and Trace_Stop (see Trace.h), from a reset system
+//with the parameters of the recording. False if the file isn't a trace of this build, or if a random draw or
+//decision differed from the recorded one, trace_position then being the record at which it diverged.
+bool MSC_Replay(const char *path);
 
 #endif
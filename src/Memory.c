@@ -1,10 +1,22 @@
 #include "Memory.h"
 
 double PROPAGATION_THRESHOLD = PROPAGATION_THRESHOLD_INITIAL;
+int PROPAGATION_ITERATIONS = PROPAGATION_ITERATIONS_INITIAL;
+bool PROPAGATION_UNTIL_CONVERGENCE = PROPAGATION_UNTIL_CONVERGENCE_INITIAL;
 
-Concept concept_storage[CONCEPTS_MAX];
+static Concept concept_array[CONCEPTS_MAX];
+Concept *concept_storage = concept_array;
 Item concept_items_storage[CONCEPTS_MAX];
 int operations_index = 0;
+//for each precondition slot and operation, a bit for the slot of each postcondition with an implication from it,
+//which may be stale as removals and recycled slots are only noticed by Memory_UnindexImplication
+#define IMPLICATION_INDEX_WORDS (CONCEPTS_MAX / 64)
+static uint64_t implication_index[CONCEPTS_MAX][OPERATIONS_MAX][IMPLICATION_INDEX_WORDS];
+int belief_spike_slots[CONCEPTS_MAX];
+int belief_spike_amount = 0;
+static bool belief_spike_listed[CONCEPTS_MAX];
+//whether the index and belief_spike_slots have to be rebuilt from the concepts before they are used
+static bool implication_index_stale = true;
 
 static void Memory_ResetEvents(void)
 {
@@ -20,9 +32,12 @@ static void Memory_ResetConcepts(void)
         concept_storage[i] = (Concept) {0};
         concepts.items[i] = (Item) { .address = &(concept_storage[i]) };
     }
+    Memory_IndexConcepts();
 }
 
 int concept_id = 0;
+long concept_generation = 0;
+long planner_search = 0;
 void Memory_INIT(void)
 {
     Memory_ResetConcepts();
@@ -55,21 +70,194 @@ bool Memory_FindConceptByTerm(Term *term, int *returnIndex)
     return false;
 }
 
+int Memory_ConceptSlot(Concept *c)
+{
+    return c - concept_storage;
+}
+
+Concept *Memory_SourceConcept(Implication *imp)
+{
+    return &concept_storage[imp->sourceConcept];
+}
+
+char *Memory_ImplicationName(Implication *imp, Concept *postc, int operationID, char *buffer)
+{
+#ifdef MSC_LEAN
+    sprintf(buffer, "<(&/,%d,^op%d(),+%ld) =/> %d>.", Memory_SourceConcept(imp)->id, operationID, imp->occurrenceTimeOffset, postc->id);
+    return buffer;
+#else
+    (void) postc; (void) operationID; (void) buffer;
+    return imp->debug;
+#endif
+}
+
+char *Memory_ConceptName(Concept *c, char *buffer)
+{
+#ifdef MSC_LEAN
+    sprintf(buffer, "%d", c->id);
+    return buffer;
+#else
+    (void) buffer;
+    return c->debug;
+#endif
+}
+
+void Memory_AttachConcept(Event *event, Concept *c)
+{
+    event->conceptSlot = Memory_ConceptSlot(c);
+    event->conceptGeneration = c->generation;
+}
+
+Concept *Memory_ResolveConcept(Event *event)
+{
+    //a hit stays valid while the slot holds the same concept, as recycling it assigns a new generation
+    if(event->conceptGeneration > 0)
+    {
+        Concept *c = &concept_storage[event->conceptSlot];
+        if(c->generation == event->conceptGeneration)
+        {
+            return c;
+        }
+    }
+    //a miss is stored as -(concept_generation+1), valid while no concept entered memory since
+    else if(event->conceptGeneration == -(concept_generation+1))
+    {
+        return NULL;
+    }
+    int conceptIndex;
+    if(Memory_FindConceptByTerm(&event->term, &conceptIndex))
+    {
+        Concept *c = concepts.items[conceptIndex].address;
+        Memory_AttachConcept(event, c);
+        return c;
+    }
+    event->conceptGeneration = -(concept_generation+1);
+    return NULL;
+}
+
+void Memory_IndexImplication(Concept *postc, int operationID, Implication *imp)
+{
+    int post = Memory_ConceptSlot(postc);
+    implication_index[imp->sourceConcept][operationID][post / 64] |= (uint64_t) 1 << (post % 64);
+}
+
+void Memory_UnindexImplication(int preSlot, int operationID, Concept *postc)
+{
+    int post = Memory_ConceptSlot(postc);
+    implication_index[preSlot][operationID][post / 64] &= ~((uint64_t) 1 << (post % 64));
+}
+
+Concept *Memory_NextPostcondition(int preSlot, int operationID, int *slot)
+{
+    for(int i = *slot; i < CONCEPTS_MAX; i = (i / 64 + 1) * 64)
+    {
+        uint64_t word = implication_index[preSlot][operationID][i / 64] >> (i % 64);
+        if(word != 0)
+        {
+            int post = i;
+            while(!(word & 1))
+            {
+                word >>= 1;
+                post++;
+            }
+            *slot = post + 1;
+            return &concept_storage[post];
+        }
+    }
+    *slot = CONCEPTS_MAX;
+    return NULL;
+}
+
+void Memory_SpikeBelief(Concept *c, Event *spike)
+{
+    c->belief_spike = *spike;
+    int slot = Memory_ConceptSlot(c);
+    if(!belief_spike_listed[slot])
+    {
+        belief_spike_listed[slot] = true;
+        belief_spike_slots[belief_spike_amount++] = slot;
+    }
+}
+
+void Memory_UnlistBeliefSpike(int index)
+{
+    belief_spike_listed[belief_spike_slots[index]] = false;
+    belief_spike_slots[index] = belief_spike_slots[--belief_spike_amount];
+}
+
+void Memory_IndexConcepts(void)
+{
+    implication_index_stale = true;
+}
+
+//the tables and spikes of every concept are visited, which also pages in the whole concept store
+void Memory_UpdateIndex(void)
+{
+    if(!implication_index_stale)
+    {
+        return;
+    }
+    implication_index_stale = false;
+    memset(implication_index, 0, sizeof(implication_index));
+    memset(belief_spike_listed, 0, sizeof(belief_spike_listed));
+    belief_spike_amount = 0;
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        Concept *c = &concept_storage[i];
+        if(c->generation == 0)
+        {
+            continue;
+        }
+        for(int opi=0; opi<OPERATIONS_MAX; opi++)
+        {
+            for(int j=0; j<c->precondition_beliefs[opi].itemsAmount; j++)
+            {
+                Memory_IndexImplication(c, opi, &c->precondition_beliefs[opi].array[j]);
+            }
+        }
+        if(c->belief_spike.type != EVENT_TYPE_DELETED)
+        {
+            Memory_SpikeBelief(c, &c->belief_spike);
+        }
+    }
+}
+
+static Concept *Memory_AddNewConcept(Term *term)
+{
+    Concept *addedConcept = NULL;
+    //try to add it, and if successful add to voting structure
+    PriorityQueue_Push_Feedback feedback = PriorityQueue_Push(&concepts, 0.0);
+    if(feedback.added)
+    {
+        addedConcept = feedback.addedItem.address;
+        long evictedGeneration = addedConcept->generation;
+        *addedConcept = (Concept) {0};
+        Concept_SetTerm(addedConcept, *term);
+        addedConcept->id = concept_id;
+        concept_id++;
+        addedConcept->generation = ++concept_generation;
+        Journal_Concept(Memory_ConceptSlot(addedConcept), addedConcept, evictedGeneration);
+    }
+    return addedConcept;
+}
+
 void Memory_Conceptualize(Term *term)
 {
     //Term_HASH_TYPE hash = Term_Hash(term);
     if(!Memory_FindConceptByTerm(term, /*hash,*/ NULL))
     {
-        Concept *addedConcept = NULL;
-        //try to add it, and if successful add to voting structure
-        PriorityQueue_Push_Feedback feedback = PriorityQueue_Push(&concepts, 0.0);
-        if(feedback.added)
+        Memory_AddNewConcept(term);
+    }
+}
+
+void Memory_ConceptualizeEvent(Event *event)
+{
+    if(Memory_ResolveConcept(event) == NULL)
+    {
+        Concept *addedConcept = Memory_AddNewConcept(&event->term);
+        if(addedConcept != NULL)
         {
-            addedConcept = feedback.addedItem.address;
-            *addedConcept = (Concept) {0};
-            Concept_SetTerm(addedConcept, *term);
-            addedConcept->id = concept_id;
-            concept_id++;
+            Memory_AttachConcept(event, addedConcept);
         }
     }
 }
@@ -97,6 +285,11 @@ void Memory_addConcept(Concept *concept, long currentTime)
     {
         Concept *toRecyle = feedback.addedItem.address;
         *toRecyle = *concept;
+        toRecyle->generation = ++concept_generation;
+        if(toRecyle->belief_spike.type != EVENT_TYPE_DELETED)
+        {
+            Memory_SpikeBelief(toRecyle, &toRecyle->belief_spike);
+        }
     }
 }
 
@@ -106,7 +299,243 @@ void Memory_addOperation(Operation op)
     operations_index++;
 }
 
+bool Memory_OperationRegistered(int index)
+{
+    return operations[index].action != 0 || operations[index].contextAction != 0;
+}
+
 bool Memory_ImplicationValid(Implication *imp)
 {
-    return Term_Equal(&imp->sourceConceptTerm, &((Concept*) imp->sourceConcept)->term);
+    return Term_Equal(&imp->sourceConceptTerm, &Memory_SourceConcept(imp)->term);
+}
+
+void Memory_RemoveImplication(Concept *c, int operationID, int index)
+{
+    Table_Remove(&c->precondition_beliefs[operationID], index);
+    Journal_Removal(Memory_ConceptSlot(c), operationID, index);
+}
+
+//the concept enters its slot as when it was created, which needs no eviction as the journal names the slot
+static bool Memory_RestoreConcept(Journal_Record *record)
+{
+    Concept *c = &concept_storage[record->slot];
+    if(c->generation != record->evictedGeneration)
+    {
+        return false;
+    }
+    //a free slot is moved behind the items to be taken by the push, an occupied one keeps its item
+    if(c->generation == 0)
+    {
+        int i = concepts.itemsAmount;
+        while(i < CONCEPTS_MAX && concepts.items[i].address != c)
+        {
+            i++;
+        }
+        if(i == CONCEPTS_MAX)
+        {
+            return false;
+        }
+        concepts.items[i] = concepts.items[concepts.itemsAmount];
+        concepts.items[concepts.itemsAmount] = (Item) { .address = c };
+        PriorityQueue_Push(&concepts, 0.0);
+    }
+    *c = (Concept) {0};
+    Concept_SetTerm(c, record->term);
+    c->id = record->id;
+    c->generation = record->generation;
+    concept_id = MAX(concept_id, record->id + 1);
+    concept_generation = MAX(concept_generation, record->generation);
+    return true;
+}
+
+bool Memory_ApplyJournalRecord(Journal_Record *record)
+{
+    if(record->type == JOURNAL_TIME)
+    {
+        base = MAX(base, record->base);
+        stampID = MIN(stampID, record->stampID);
+        return true;
+    }
+    if(record->slot < 0 || record->slot >= CONCEPTS_MAX)
+    {
+        return false;
+    }
+    if(record->type == JOURNAL_CONCEPT)
+    {
+        return record->generation > 0 && Memory_RestoreConcept(record);
+    }
+    Concept *c = &concept_storage[record->slot];
+    if(c->generation == 0 || record->operationID < 0 || record->operationID >= OPERATIONS_MAX)
+    {
+        return false;
+    }
+    Table *table = &c->precondition_beliefs[record->operationID];
+    if(record->type == JOURNAL_REMOVAL)
+    {
+        if(record->index < 0 || record->index >= table->itemsAmount)
+        {
+            return false;
+        }
+        Table_Remove(table, record->index);
+        return true;
+    }
+    //like Table_AddAndRevise, the implication replaces the one of the same term
+    Implication *imp = &record->implication;
+    if(imp->sourceConcept < 0 || imp->sourceConcept >= CONCEPTS_MAX)
+    {
+        return false;
+    }
+    for(int i=0; i<table->itemsAmount; i++)
+    {
+        if(Term_Equal(&imp->term, &table->array[i].term))
+        {
+            Table_Remove(table, i);
+            break;
+        }
+    }
+    Implication *added = Table_Add(table, imp);
+    if(added != NULL)
+    {
+        Memory_IndexImplication(c, record->operationID, added);
+    }
+    return added != NULL;
+}
+
+//a concept store is this header followed by the CONCEPTS_MAX concepts as laid out in memory
+typedef struct
+{
+    char magic[8];
+    int version;
+    int conceptSize;
+    int conceptsMax;
+    int conceptId;
+    long conceptGeneration;
+    long base;
+    int stampID;
+    long planner_search;
+    //the time and the concept queue by slot, as of the last sync
+    long time;
+    int itemsAmount;
+    int itemSlots[CONCEPTS_MAX];
+    double priorities[CONCEPTS_MAX];
+} Memory_ConceptStore;
+static Memory_ConceptStore *concept_store = NULL;
+#define CONCEPT_STORE_SIZE (sizeof(Memory_ConceptStore) + CONCEPTS_MAX * sizeof(Concept))
+
+//the queue of the last sync, in which every slot appears once, as a crash may have left another header behind
+static bool Memory_ValidStoreQueue(Memory_ConceptStore *store)
+{
+    static bool listed[CONCEPTS_MAX];
+    memset(listed, 0, sizeof(listed));
+    if(store->itemsAmount < 0 || store->itemsAmount > CONCEPTS_MAX)
+    {
+        return false;
+    }
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        int slot = store->itemSlots[i];
+        if(slot < 0 || slot >= CONCEPTS_MAX || listed[slot])
+        {
+            return false;
+        }
+        listed[slot] = true;
+    }
+    return true;
+}
+
+//the queue is taken from the header, so mapping reads and writes none of the concepts: they keep their priorities,
+//usage and spikes as the time continues from the one they were stored at, and the index is only built once needed.
+//A concept which entered memory after the last sync is left in a free slot, to be reused.
+static void Memory_RebuildConcepts(Memory_ConceptStore *store)
+{
+    PriorityQueue_RESET(&concepts, concept_items_storage, CONCEPTS_MAX);
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        concepts.items[i] = (Item) { .priority = store->priorities[i], .address = &(concept_storage[store->itemSlots[i]]) };
+    }
+    concepts.itemsAmount = store->itemsAmount;
+    Memory_IndexConcepts();
+}
+
+bool Memory_MapConcepts(const char *path, long *currentTime)
+{
+    Memory_UnmapConcepts(*currentTime);
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(fd < 0)
+    {
+        return false;
+    }
+    off_t existing = lseek(fd, 0, SEEK_END);
+    //a new file is extended to the store size, its concepts reading as unused
+    bool sized = existing == (off_t) CONCEPT_STORE_SIZE ||
+                 (existing == 0 && lseek(fd, CONCEPT_STORE_SIZE - 1, SEEK_SET) >= 0 && write(fd, "", 1) == 1);
+    void *mapped = sized ? mmap(NULL, CONCEPT_STORE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if(mapped == MAP_FAILED)
+    {
+        return false;
+    }
+    Memory_ConceptStore *store = mapped;
+    if(existing == 0)
+    {
+        *store = (Memory_ConceptStore) { .magic = "MSCSTOR", .version = CONCEPT_STORE_VERSION,
+                                         .conceptSize = sizeof(Concept), .conceptsMax = CONCEPTS_MAX, .stampID = -1 };
+        for(int i=0; i<CONCEPTS_MAX; i++)
+        {
+            store->itemSlots[i] = i;
+        }
+    }
+    if(strncmp(store->magic, "MSCSTOR", sizeof(store->magic)) || store->version != CONCEPT_STORE_VERSION ||
+       store->conceptSize != (int) sizeof(Concept) || store->conceptsMax != CONCEPTS_MAX || !Memory_ValidStoreQueue(store))
+    {
+        munmap(mapped, CONCEPT_STORE_SIZE);
+        return false;
+    }
+    concept_store = store;
+    concept_storage = (Concept*) (store + 1);
+    concept_id = store->conceptId;
+    //generations stay unique, also towards handles cached before
+    concept_generation = MAX(concept_generation, store->conceptGeneration);
+    //new evidence must not overlap with the stamps of the stored implications
+    base = MAX(base, store->base);
+    stampID = MIN(stampID, store->stampID);
+    //the planner marks and usage times of the stored concepts stay older than the next ones
+    planner_search = MAX(planner_search, store->planner_search);
+    *currentTime = MAX(*currentTime, store->time);
+    Memory_RebuildConcepts(store);
+    return true;
+}
+
+bool Memory_SyncConcepts(long currentTime)
+{
+    if(concept_store == NULL)
+    {
+        return false;
+    }
+    concept_store->conceptId = concept_id;
+    concept_store->conceptGeneration = concept_generation;
+    concept_store->base = base;
+    concept_store->stampID = stampID;
+    concept_store->planner_search = planner_search;
+    concept_store->time = currentTime;
+    concept_store->itemsAmount = concepts.itemsAmount;
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        concept_store->itemSlots[i] = Memory_ConceptSlot(concepts.items[i].address);
+        concept_store->priorities[i] = concepts.items[i].priority;
+    }
+    return msync(concept_store, CONCEPT_STORE_SIZE, MS_SYNC) == 0;
+}
+
+void Memory_UnmapConcepts(long currentTime)
+{
+    if(concept_store != NULL)
+    {
+        Memory_SyncConcepts(currentTime);
+        munmap(concept_store, CONCEPT_STORE_SIZE);
+        concept_store = NULL;
+        concept_storage = concept_array;
+        Memory_ResetConcepts();
+        concept_id = 0;
+    }
 }
@@ -8,31 +8,60 @@
 
 //References//
 //////////////
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "Concept.h"
 #include "PriorityQueue.h"
+#include "Journal.h"
 
 //Parameters//
 //----------//
 #define CONCEPTS_MAX 1024 //always adjust both
 #define USE_HASHING true
+//size of the buffers names are derived into
+#define MEMORY_NAME_LEN 100
 #define PROPAGATE_GOAL_SPIKES true
 #define PROPAGATION_THRESHOLD_INITIAL 0.501
 extern double PROPAGATION_THRESHOLD;
-#define PROPAGATION_ITERATIONS 5
+#define PROPAGATION_ITERATIONS_INITIAL 5
+extern int PROPAGATION_ITERATIONS;
+//stop propagating once a sweep adds no new above-threshold goal spike, as further sweeps can't change anything
+#define PROPAGATION_UNTIL_CONVERGENCE_INITIAL true
+extern bool PROPAGATION_UNTIL_CONVERGENCE;
+#define CONCEPT_STORE_VERSION 3
 
 //Data structure//
 //--------------//
 //Data structures
 PriorityQueue concepts;
+//the CONCEPTS_MAX concepts, which the items of the queue point to, in process memory or a mapped concept store
+extern Concept *concept_storage;
 FIFO belief_events;
 FIFO goal_events;
 typedef void (*Action)(void);
+//callback receiving the registered user context and the desire of the decision
+typedef void (*ContextAction)(void *user, double desire);
 typedef struct
 {
     Term term;
     Action action;
+    ContextAction contextAction;
+    void *user;
 }Operation;
 Operation operations[OPERATIONS_MAX];
+//incremented whenever a concept enters memory, the concept takes it as its generation
+extern long concept_generation;
+//id of the next new concept, and index of the next operation to add
+extern int concept_id;
+extern int operations_index;
+//the search the planner marks the concepts it reaches with, counting on from the marks of stored concepts
+extern long planner_search;
+//the slots of the concepts which got a belief spike, kept listed until Memory_UnlistBeliefSpike
+extern int belief_spike_slots[CONCEPTS_MAX];
+extern int belief_spike_amount;
 
 //Methods//
 //-------//
@@ -40,15 +69,62 @@ Operation operations[OPERATIONS_MAX];
 void Memory_INIT(void);
 //Find a concept
 bool Memory_FindConceptByTerm(Term *term, /*Term_HASH_TYPE term_hash,*/ int *returnIndex);
+//Find the concept of an event, using and refreshing the handle cached in the event
+Concept *Memory_ResolveConcept(Event *event);
+//Cache a concept already known to be the event's in the event
+void Memory_AttachConcept(Event *event, Concept *c);
+//Index of the storage slot of the concept, in [0, CONCEPTS_MAX)
+int Memory_ConceptSlot(Concept *c);
+//The concept in the slot the implication was formed from, which may have been recycled (see Memory_ImplicationValid)
+Concept *Memory_SourceConcept(Implication *imp);
+//The debug name of the implication in the table of postc for the operation, derived into the buffer
+//of MEMORY_NAME_LEN from the ids of the concepts in a lean build
+char *Memory_ImplicationName(Implication *imp, Concept *postc, int operationID, char *buffer);
+//The debug name of the concept, or its id written into the buffer in a lean build
+char *Memory_ConceptName(Concept *c, char *buffer);
 //Create a new concept
 void Memory_Conceptualize(Term *term);
+//Create a new concept for the event if it has none, caching the handle in the event
+void Memory_ConceptualizeEvent(Event *event);
 //Add an already existing concept to memory that was taken out from the concept priority queue
 void Memory_addConcept(Concept *concept, long currentTime);
 //Add event to memory
 bool Memory_addEvent(Event *event);
 //Add operation to memory
 void Memory_addOperation(Operation op);
+//whether an operation is registered at the index
+bool Memory_OperationRegistered(int index);
 //check if implication is still valid (source concept might be forgotten)
 bool Memory_ImplicationValid(Implication *imp);
+//Remove the implication at index from the concept's table of the operation
+void Memory_RemoveImplication(Concept *c, int operationID, int index);
+//Index the implication of postc's table for the operation under the slot of its precondition concept
+void Memory_IndexImplication(Concept *postc, int operationID, Implication *imp);
+//Drop postc from the index of the precondition slot and operation, as it holds no implication from it anymore
+void Memory_UnindexImplication(int preSlot, int operationID, Concept *postc);
+//The next concept from *slot on indexed as having an implication from the precondition slot for the operation,
+//advancing *slot behind it, NULL at the end. Start with *slot = 0, the index may hold stale entries.
+Concept *Memory_NextPostcondition(int preSlot, int operationID, int *slot);
+//Set the belief spike of the concept, listing the concept in belief_spike_slots
+void Memory_SpikeBelief(Concept *c, Event *spike);
+//Remove the entry at index from belief_spike_slots, the last one taking its place
+void Memory_UnlistBeliefSpike(int index);
+//Rebuild the implication index and belief_spike_slots from the concepts when they are next needed (Memory_UpdateIndex),
+//after the concepts were replaced as a whole
+void Memory_IndexConcepts(void);
+//Rebuild the implication index and belief_spike_slots if Memory_IndexConcepts was called since they were last built
+void Memory_UpdateIndex(void);
+//Apply a change recorded in the journal to the concepts, false if it doesn't fit them
+bool Memory_ApplyJournalRecord(Journal_Record *record);
+//Keep the concepts in the file, created if missing, instead of process memory. The concepts stored in it become the
+//memory with the concept queue of the last sync, and the time continues from the one of the last sync if that's later.
+//Their terms refer to the dictionary of when they were stored. False if the file can't be mapped or holds a store
+//of another version or layout. Hosts use MSC_MapConcepts, which also drops the anticipations and plans pointing
+//into the previous concepts.
+bool Memory_MapConcepts(const char *path, long *currentTime);
+//Write the mapped concepts, the concept queue, the counters and the time to the file, false on error or if none is mapped
+bool Memory_SyncConcepts(long currentTime);
+//Sync and unmap the concept store, leaving an empty memory in process memory again (see MSC_UnmapConcepts)
+void Memory_UnmapConcepts(long currentTime);
 
 #endif
@@ -0,0 +1,175 @@
+//syscall isn't POSIX
+#define _DEFAULT_SOURCE
+#include "Perf.h"
+
+const char *perf_counter_names[PERF_COUNTERS] = { "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses" };
+static int perf_leader = -1;
+static int perf_fds[PERF_COUNTERS];
+//position of each counter in the values of the group, -1 if it couldn't be opened
+static int perf_index[PERF_COUNTERS] = { -1, -1, -1, -1, -1 };
+static int perf_opened = 0;
+static int perf_errno = 0;
+
+#ifdef __linux__
+static int Perf_OpenCounter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    //the group only starts once all its counters are opened
+    attr.disabled = perf_leader < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, perf_leader, 0);
+}
+#endif
+
+bool Perf_Open(void)
+{
+    if(perf_leader >= 0)
+    {
+        return true;
+    }
+    perf_opened = 0;
+    perf_errno = 0;
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        perf_index[i] = -1;
+    }
+#ifdef __linux__
+    uint32_t types[PERF_COUNTERS] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+    uint64_t configs[PERF_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+                                        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        int fd = Perf_OpenCounter(types[i], configs[i]);
+        if(fd < 0)
+        {
+            perf_errno = errno;
+            continue;
+        }
+        if(perf_leader < 0)
+        {
+            perf_leader = fd;
+        }
+        perf_fds[i] = fd;
+        perf_index[i] = perf_opened++;
+    }
+    if(perf_leader < 0)
+    {
+        return false;
+    }
+    ioctl(perf_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    perf_errno = ENOSYS;
+    return false;
+#endif
+}
+
+void Perf_Close(void)
+{
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        if(perf_index[i] >= 0)
+        {
+            close(perf_fds[i]);
+            perf_index[i] = -1;
+        }
+    }
+    perf_leader = -1;
+    perf_opened = 0;
+}
+
+bool Perf_Counting(int counter)
+{
+    return perf_leader >= 0 && perf_index[counter] >= 0;
+}
+
+const char *Perf_Error(void)
+{
+    switch(perf_errno)
+    {
+        case 0: return NULL;
+        case ENOENT:
+        case EOPNOTSUPP: return "not supported by the CPU or kernel";
+        case EACCES:
+        case EPERM: return "not permitted, see /proc/sys/kernel/perf_event_paranoid";
+        case ENOSYS: return "no perf_event_open";
+    }
+    return strerror(perf_errno);
+}
+
+void Perf_Read(Perf_Counts *counts)
+{
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        counts->values[i] = PERF_UNAVAILABLE;
+    }
+    //the amount of values, the time the group was enabled and running, and the values
+    uint64_t group[3 + PERF_COUNTERS];
+    if(perf_leader < 0 || read(perf_leader, group, sizeof(group)) < (ssize_t) (3 * sizeof(uint64_t)) || group[2] == 0)
+    {
+        return;
+    }
+    double scale = group[1] / (double) group[2];
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        if(perf_index[i] >= 0 && perf_index[i] < (int) group[0])
+        {
+            counts->values[i] = group[3 + perf_index[i]] * scale;
+        }
+    }
+}
+
+void Perf_Since(Perf_Counts *start, Perf_Counts *elapsed)
+{
+    Perf_Read(elapsed);
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        if(elapsed->values[i] != PERF_UNAVAILABLE && start->values[i] != PERF_UNAVAILABLE)
+        {
+            elapsed->values[i] -= start->values[i];
+        }
+        else
+        {
+            elapsed->values[i] = PERF_UNAVAILABLE;
+        }
+    }
+}
+
+void Perf_Print(Perf_Counts *counts, FILE *out)
+{
+    long long *v = counts->values;
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        if(v[i] != PERF_UNAVAILABLE)
+        {
+            fprintf(out, "%s%s=%lld", i ? " " : "", perf_counter_names[i], v[i]);
+        }
+        else
+        {
+            fprintf(out, "%s%s=n/a", i ? " " : "", perf_counter_names[i]);
+        }
+    }
+    if(v[PERF_CYCLES] > 0 && v[PERF_INSTRUCTIONS] != PERF_UNAVAILABLE)
+    {
+        fprintf(out, " IPC=%.2f", v[PERF_INSTRUCTIONS] / (double) v[PERF_CYCLES]);
+    }
+    if(v[PERF_INSTRUCTIONS] > 0)
+    {
+        for(int i=PERF_L1D_MISSES; i<PERF_COUNTERS; i++)
+        {
+            if(v[i] != PERF_UNAVAILABLE)
+            {
+                fprintf(out, " %s/kinst=%.2f", perf_counter_names[i], 1000.0 * v[i] / v[PERF_INSTRUCTIONS]);
+            }
+        }
+    }
+    fputc('\n', out);
+}
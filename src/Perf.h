@@ -0,0 +1,62 @@
+#ifndef H_PERF
+#define H_PERF
+
+////////////////
+//  MSC Perf  //
+////////////////
+//Hardware performance counters of the process, counted in user space as one group which is read
+//with a single system call. Counters the CPU, kernel or container doesn't offer are left out, and if
+//none can be opened (or not on Linux) every count reads as unavailable, so callers fall back to
+//their wall-clock numbers.
+
+//References//
+//-----------//
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+//Parameters//
+//----------//
+#define PERF_CYCLES 0
+#define PERF_INSTRUCTIONS 1
+#define PERF_L1D_MISSES 2
+#define PERF_LLC_MISSES 3
+#define PERF_BRANCH_MISSES 4
+#define PERF_COUNTERS 5
+//the count of a counter which isn't available
+#define PERF_UNAVAILABLE -1
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    //scaled to the whole time if the kernel multiplexed the group
+    long long values[PERF_COUNTERS];
+} Perf_Counts;
+extern const char *perf_counter_names[PERF_COUNTERS];
+
+//Methods//
+//-------//
+//Open and start the counters which are available, false if none is
+bool Perf_Open(void);
+void Perf_Close(void);
+//Whether the counter is being counted
+bool Perf_Counting(int counter);
+//Why a counter couldn't be opened, NULL if all were
+const char *Perf_Error(void);
+//The counts since Perf_Open, PERF_UNAVAILABLE for the counters not being counted
+void Perf_Read(Perf_Counts *counts);
+//The counts since the start counts were read
+void Perf_Since(Perf_Counts *start, Perf_Counts *elapsed);
+//Print the counts, the instructions per cycle, and the misses per thousand instructions
+void Perf_Print(Perf_Counts *counts, FILE *out);
+
+#endif
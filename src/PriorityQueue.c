@@ -5,6 +5,7 @@ void PriorityQueue_RESET(PriorityQueue *queue, Item *items, int maxElements)
     queue->items = items;
     queue->maxElements = maxElements;
     queue->itemsAmount = 0;
+    queue->modified = true;
 }
 
 #define at(i) (queue->items[i])
@@ -175,6 +176,7 @@ PriorityQueue_Push_Feedback PriorityQueue_Push(PriorityQueue *queue, double prio
         at(queue->itemsAmount).address = feedback.evictedItem.address; 
     }
     feedback.added = true;
+    queue->modified = true;
     feedback.addedItem = at(queue->itemsAmount);
     queue->itemsAmount++;
     bubbleUp(queue, queue->itemsAmount-1);
@@ -190,6 +192,7 @@ bool PriorityQueue_PopAt(PriorityQueue *queue, int i, void** returnItemAddress)
     Item item = at(i);
     swap(queue, i, queue->itemsAmount-1); 
     queue->itemsAmount--;
+    queue->modified = true;
     trickleDown(queue, i, true); //enforce minmax heap property
     if(returnItemAddress != NULL)
     {
@@ -198,10 +201,26 @@ bool PriorityQueue_PopAt(PriorityQueue *queue, int i, void** returnItemAddress)
     return true;
 }
 
+bool PriorityQueue_PopMax(PriorityQueue *queue, void** returnItemAddress)
+{
+    //the maximum is the root if alone, else one of its children on the first max level
+    int i = 0;
+    if(queue->itemsAmount > 1)
+    {
+        i = 1;
+    }
+    if(queue->itemsAmount > 2 && at(2).priority > at(1).priority)
+    {
+        i = 2;
+    }
+    return PriorityQueue_PopAt(queue, i, returnItemAddress);
+}
+
 void PriorityQueue_Rebuild(PriorityQueue *queue)
 {
     for(int i=0; i<queue->itemsAmount; i++)
     {
         bubbleUp(queue, i);
     }
+    queue->modified = false;
 }
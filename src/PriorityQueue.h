@@ -26,6 +26,8 @@ typedef struct
     Item *items;
     int itemsAmount;
     int maxElements;
+    //whether items were added or removed since the last rebuild
+    bool modified;
 } PriorityQueue;
 
 typedef struct
@@ -45,6 +47,8 @@ void PriorityQueue_RESET(PriorityQueue *queue, Item *items, int maxElements);
 PriorityQueue_Push_Feedback PriorityQueue_Push(PriorityQueue *queue, double priority);
 //use this function and add again if maybe lower!
 bool PriorityQueue_PopAt(PriorityQueue *queue, int i, void** returnItemAddress);
+//Pop the element of highest priority, false if the queue is empty
+bool PriorityQueue_PopMax(PriorityQueue *queue, void** returnItemAddress);
 //Rebuilds the data structure by re-inserting all elements:
 void PriorityQueue_Rebuild(PriorityQueue *queue);
 
@@ -0,0 +1,105 @@
+#include "Profile.h"
+
+bool PROFILING = PROFILING_INITIAL;
+Profile_Stats profile_stats = {0};
+const char *profile_phase_names[PROFILE_PHASES] = { "anticipations", "events", "assumption of failure", "mining", "goals",
+                                                    "propagation", "execution", "spike reset", "rebuild" };
+//the start and previous lap of each cycle being timed, the outer ones being paused
+typedef struct
+{
+    long start;
+    long lap;
+    Perf_Counts startCounts;
+    Perf_Counts lapCounts;
+} Profile_Timing;
+static Profile_Timing profile_timings[PROFILE_DEPTH_MAX];
+static int profile_depth = 0;
+
+void Profile_Start(void)
+{
+    profile_stats.cycles++;
+    profile_depth++;
+    if(profile_depth <= PROFILE_DEPTH_MAX)
+    {
+        Profile_Timing *timing = &profile_timings[profile_depth-1];
+        Perf_Read(&timing->startCounts);
+        timing->lapCounts = timing->startCounts;
+        timing->start = timing->lap = Globals_Nanoseconds();
+    }
+}
+
+void Profile_Lap(int phase)
+{
+    if(profile_depth == 0 || profile_depth > PROFILE_DEPTH_MAX)
+    {
+        return;
+    }
+    Profile_Timing *timing = &profile_timings[profile_depth-1];
+    long now = Globals_Nanoseconds();
+    profile_stats.nanoseconds[phase] += now - timing->lap;
+    timing->lap = now;
+    Perf_Counts counts;
+    Perf_Read(&counts);
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        if(counts.values[i] != PERF_UNAVAILABLE && timing->lapCounts.values[i] != PERF_UNAVAILABLE)
+        {
+            profile_stats.counters[phase].values[i] += counts.values[i] - timing->lapCounts.values[i];
+            profile_stats.counted = true;
+        }
+    }
+    timing->lapCounts = counts;
+}
+
+void Profile_Stop(void)
+{
+    if(profile_depth == 0)
+    {
+        return;
+    }
+    //the phase of the outer cycle continues as if the nested one took no time
+    if(profile_depth > 1 && profile_depth <= PROFILE_DEPTH_MAX)
+    {
+        Profile_Timing *nested = &profile_timings[profile_depth-1];
+        Profile_Timing *outer = &profile_timings[profile_depth-2];
+        outer->lap += Globals_Nanoseconds() - nested->start;
+        Perf_Counts counts;
+        Perf_Read(&counts);
+        for(int i=0; i<PERF_COUNTERS; i++)
+        {
+            if(counts.values[i] != PERF_UNAVAILABLE && nested->startCounts.values[i] != PERF_UNAVAILABLE)
+            {
+                outer->lapCounts.values[i] += counts.values[i] - nested->startCounts.values[i];
+            }
+        }
+    }
+    profile_depth--;
+}
+
+void Profile_Print(Profile_Stats *stats, FILE *out)
+{
+    long total = 0;
+    for(int i=0; i<PROFILE_PHASES; i++)
+    {
+        total += stats->nanoseconds[i];
+    }
+    fprintf(out, "cycles=%ld profiled ms=%.3f us/cycle=%.2f\n", stats->cycles, total / 1e6, total / 1e3 / MAX(1, stats->cycles));
+    for(int i=0; i<PROFILE_PHASES; i++)
+    {
+        fprintf(out, "  %-22s ms=%10.3f share=%5.1f%% ns/cycle=%.0f\n", profile_phase_names[i], stats->nanoseconds[i] / 1e6,
+                100.0 * stats->nanoseconds[i] / MAX(1, total), stats->nanoseconds[i] / (double) MAX(1, stats->cycles));
+        if(stats->counted)
+        {
+            Perf_Counts counts = stats->counters[i];
+            for(int j=0; j<PERF_COUNTERS; j++)
+            {
+                counts.values[j] = Perf_Counting(j) ? counts.values[j] : PERF_UNAVAILABLE;
+            }
+            fputs("    ", out);
+            Perf_Print(&counts, out);
+        }
+    }
+    fprintf(out, "  pairs mined=%ld implications formed=%ld revised=%ld spikes propagated=%ld decisions=%ld concepts skipped=%ld\n",
+            stats->pairsMined, stats->implicationsFormed, stats->implicationsRevised, stats->spikesPropagated, stats->decisions,
+            stats->conceptsSkipped);
+}
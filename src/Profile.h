@@ -0,0 +1,73 @@
+#ifndef H_PROFILE
+#define H_PROFILE
+
+///////////////////
+//  MSC Profile  //
+///////////////////
+//What the phases of the cycles took and the work they did, to tell which one dominates a workload.
+//While PROFILING each phase adds the time since the previous one ended, so a cycle costs a clock
+//read per phase, and nothing but the check of the flag when disabled. If hardware counters were
+//opened (see Perf.h), each phase also adds their counts, for a read of the group per phase.
+//A cycle nested in a phase, as by the feedback of an immediate execution, pauses that phase.
+
+//References//
+//-----------//
+#include <stdio.h>
+#include "Globals.h"
+#include "Perf.h"
+
+//Parameters//
+//----------//
+#define PROFILING_INITIAL false
+extern bool PROFILING;
+#define IN_PROFILING(x) {if(PROFILING){ x } }
+//the phases of a cycle in the order they run, the anticipations being both expired and confirmed
+#define PROFILE_ANTICIPATIONS 0
+#define PROFILE_EVENTS 1
+#define PROFILE_ASSUMPTION_OF_FAILURE 2
+#define PROFILE_MINING 3
+#define PROFILE_GOALS 4
+#define PROFILE_PROPAGATION 5
+#define PROFILE_EXECUTION 6
+#define PROFILE_SPIKE_RESET 7
+#define PROFILE_REBUILD 8
+#define PROFILE_PHASES 9
+//cycles nested deeper are timed as part of the phase of the outermost one timed
+#define PROFILE_DEPTH_MAX 8
+
+//Data structure//
+//--------------//
+//What the cycles took while PROFILING, summed until reset
+typedef struct
+{
+    long cycles;
+    long nanoseconds[PROFILE_PHASES];
+    //event pairs temporal induction was applied to, the implications of sufficient confidence they formed,
+    //and those which were revised with an existing one
+    long pairsMined;
+    long implicationsFormed;
+    long implicationsRevised;
+    //goal spikes derived for a precondition, by a propagation sweep or a step of the best-first plan
+    long spikesPropagated;
+    long decisions;
+    //concepts the spike removal and the re-sorting at the end of a cycle didn't have to visit
+    long conceptsSkipped;
+    //the hardware counts of each phase, if a counter was read
+    bool counted;
+    Perf_Counts counters[PROFILE_PHASES];
+} Profile_Stats;
+extern Profile_Stats profile_stats;
+extern const char *profile_phase_names[PROFILE_PHASES];
+
+//Methods//
+//-------//
+//Start timing a cycle, pausing the phase of the cycle it's nested in until Profile_Stop
+void Profile_Start(void);
+//Add the time and counts since the previous lap of the current cycle to the phase
+void Profile_Lap(int phase);
+//Stop timing the current cycle, resuming the phase of the cycle it's nested in
+void Profile_Stop(void);
+//Print the time of each phase, its share and its mean per cycle, the hardware counts, and the work counters
+void Profile_Print(Profile_Stats *stats, FILE *out);
+
+#endif
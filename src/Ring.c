@@ -0,0 +1,44 @@
+#include "Ring.h"
+
+//head and tail grow monotonically, the slot is obtained by masking
+
+void Ring_RESET(Ring *ring)
+{
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+int Ring_Reserve(Ring *ring, int size)
+{
+    unsigned long tail = LOAD_RELAXED(ring->tail);
+    if(tail - LOAD_ACQUIRE(ring->head) >= (unsigned long) size)
+    {
+        return -1;
+    }
+    return (int) (tail & (size - 1));
+}
+
+void Ring_Commit(Ring *ring)
+{
+    STORE_RELEASE(ring->tail, LOAD_RELAXED(ring->tail) + 1);
+}
+
+int Ring_Front(Ring *ring, int size)
+{
+    unsigned long head = LOAD_RELAXED(ring->head);
+    if(head == LOAD_ACQUIRE(ring->tail))
+    {
+        return -1;
+    }
+    return (int) (head & (size - 1));
+}
+
+void Ring_Release(Ring *ring)
+{
+    STORE_RELEASE(ring->head, LOAD_RELAXED(ring->head) + 1);
+}
+
+int Ring_Size(Ring *ring)
+{
+    return (int) (LOAD_ACQUIRE(ring->tail) - LOAD_ACQUIRE(ring->head));
+}
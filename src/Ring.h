@@ -0,0 +1,46 @@
+#ifndef H_RING
+#define H_RING
+
+///////////////////////////////////////////
+//  Ring (single producer/consumer)      //
+///////////////////////////////////////////
+//The indices of a lock-free ring buffer, shared by the input ring and the
+//event log ring, which each keep the entries in an array of their own type.
+//Only one producer and one consumer are supported. The entries are written
+//in place by the producer and read in place by the consumer, the indices
+//publishing them with acquire/release ordering.
+
+//References//
+//-----------//
+#include <stdbool.h>
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    //written by the consumer only
+    unsigned long head;
+    //written by the producer only
+    unsigned long tail;
+} Ring;
+//for flags shared with the thread at the other end
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define LOAD_RELAXED(x) __atomic_load_n(&(x), __ATOMIC_RELAXED)
+#define STORE_RELEASE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+
+//Methods//
+//-------//
+//Resets the ring, must not be called while producer or consumer are active
+void Ring_RESET(Ring *ring);
+//Producer: the slot of the next free entry of a ring of size entries (a power of two), -1 if it is full
+int Ring_Reserve(Ring *ring, int size);
+//Producer: publish the slot obtained by Ring_Reserve
+void Ring_Commit(Ring *ring);
+//Consumer: the slot of the oldest published entry of a ring of size entries, -1 if it is empty
+int Ring_Front(Ring *ring, int size);
+//Consumer: free the slot obtained by Ring_Front
+void Ring_Release(Ring *ring);
+//Amount of published entries not yet released
+int Ring_Size(Ring *ring);
+
+#endif
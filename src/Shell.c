@@ -0,0 +1,354 @@
+#include "Shell.h"
+
+//the names of the terms first encoded by the shell, as Encode_Term keeps the pointer
+static char shell_names[TERMS_ENCODABLE][TERMS_LEN+1];
+//where the operations answer their execution
+static FILE *shell_out = NULL;
+static long shell_line = 0;
+
+static char *Shell_SkipSpaces(char *s)
+{
+    while(*s == ' ' || *s == '\t' || *s == '\r')
+    {
+        s++;
+    }
+    return s;
+}
+
+static bool Shell_IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+//the argument of a command up to trailing spaces, terminated in place
+static char *Shell_Argument(char *s)
+{
+    char *end = s + strlen(s);
+    while(end > s && Shell_IsSpace(end[-1]))
+    {
+        end--;
+    }
+    *end = 0;
+    return s;
+}
+
+static bool Shell_ParseTruth(char *s, Truth *truth, char **rest)
+{
+    char *end;
+    truth->frequency = strtod(s, &end);
+    if(end == s)
+    {
+        return false;
+    }
+    if(*end == ';')
+    {
+        s = end+1;
+        truth->confidence = strtod(s, &end);
+        if(end == s)
+        {
+            return false;
+        }
+    }
+    *rest = end;
+    return truth->frequency >= 0.0 && truth->frequency <= 1.0 && truth->confidence > 0.0 && truth->confidence < 1.0;
+}
+
+static bool Shell_ParseCommand(char *s, Shell_Command *command)
+{
+    char *word = s;
+    while(*s != 0 && !Shell_IsSpace(*s))
+    {
+        s++;
+    }
+    char *end = s;
+    s = Shell_SkipSpaces(s);
+    *end = 0;
+    command->name = Shell_Argument(s);
+    bool argument = command->name[0] != 0;
+    static const struct { const char *word; int type; bool argument; } commands[] = {
+        {"op", SHELL_OPERATION, true}, {"reset", SHELL_RESET, false}, {"time", SHELL_TIME, false},
+        {"concepts", SHELL_CONCEPTS, false}, {"save", SHELL_SAVE, true}, {"load", SHELL_LOAD, true},
+        {"graph", SHELL_GRAPH, true} };
+    for(size_t i=0; i<sizeof(commands)/sizeof(commands[0]); i++)
+    {
+        if(!strcmp(word, commands[i].word))
+        {
+            command->type = commands[i].type;
+            return argument == commands[i].argument;
+        }
+    }
+    return false;
+}
+
+bool Shell_Parse(char *line, Shell_Command *command)
+{
+    *command = (Shell_Command) { .type = SHELL_EMPTY, .truth = MSC_DEFAULT_TRUTH };
+    char *s = Shell_SkipSpaces(line);
+    if(*s == 0 || (s[0] == '/' && s[1] == '/'))
+    {
+        return true;
+    }
+    if(isdigit((unsigned char) *s))
+    {
+        char *end;
+        command->type = SHELL_CYCLES;
+        command->cycles = strtol(s, &end, 10);
+        return *Shell_SkipSpaces(end) == 0 && command->cycles <= INT_MAX;
+    }
+    if(*s == '*')
+    {
+        return Shell_ParseCommand(s+1, command);
+    }
+    command->name = s;
+    while(*s != 0 && *s != '.' && *s != '!' && *s != '?' && !Shell_IsSpace(*s))
+    {
+        s++;
+    }
+    char punctuation = *s;
+    if(s == command->name || s - command->name > TERMS_LEN || (punctuation != '.' && punctuation != '!' && punctuation != '?'))
+    {
+        return false;
+    }
+    *s = 0;
+    command->type = punctuation == '.' ? SHELL_BELIEF : punctuation == '!' ? SHELL_GOAL : SHELL_QUESTION;
+    s = Shell_SkipSpaces(s+1);
+    //all inputs are events
+    if(!strncmp(s, ":|:", 3))
+    {
+        s = Shell_SkipSpaces(s+3);
+    }
+    if(*s == '%' && command->type != SHELL_QUESTION)
+    {
+        if(!Shell_ParseTruth(s+1, &command->truth, &s) || *s != '%')
+        {
+            return false;
+        }
+        s = Shell_SkipSpaces(s+1);
+    }
+    return *s == 0;
+}
+
+//the term of the name, encoding it on first use if asked to, false if it has none or can't be encoded
+static bool Shell_Term(char *name, Term *term, bool encode)
+{
+    *term = (Term) {0};
+    for(int i=0; i<term_index; i++)
+    {
+        if(!strcmp(terms[i], name))
+        {
+            term->terms[0] = i+1;
+            return true;
+        }
+    }
+    if(!encode || term_index >= TERMS_ENCODABLE || strlen(name) > TERMS_LEN)
+    {
+        return false;
+    }
+    strcpy(shell_names[term_index], name);
+    *term = Encode_Term(shell_names[term_index]);
+    return true;
+}
+
+//the id of the registered operation of the term, 0 if there is none
+static int Shell_OperationID(Term *term)
+{
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        if(Memory_OperationRegistered(i) && Term_Equal(&operations[i].term, term))
+        {
+            return i+1;
+        }
+    }
+    return 0;
+}
+
+static void Shell_Executed(void *user, double desire)
+{
+    (void) desire;
+    fprintf(shell_out, "%s executed\n", (char*) user);
+}
+
+static void Shell_PrintAtom(FILE *out, int number)
+{
+    fputs(number <= term_index ? terms[number-1] : "?", out);
+}
+
+//the best valid implication predicting the term, per operation
+static void Shell_Answer(Term *term, FILE *out)
+{
+    int index;
+    bool answered = false;
+    Concept *c = term != NULL && Memory_FindConceptByTerm(term, &index) ? concepts.items[index].address : NULL;
+    for(int opi=0; c != NULL && opi<OPERATIONS_MAX; opi++)
+    {
+        Table *table = &c->precondition_beliefs[opi];
+        for(int j=0; j<table->itemsAmount; j++)
+        {
+            Implication *imp = &table->array[j];
+            if(Memory_ImplicationValid(imp))
+            {
+                fputs("Answer: <(&/,", out);
+                Term_Format(out, &imp->term, Shell_PrintAtom);
+                if(opi > 0)
+                {
+                    fputc(',', out);
+                    Term_Format(out, &operations[opi-1].term, Shell_PrintAtom);
+                }
+                fprintf(out, ",+%ld) =/> ", imp->occurrenceTimeOffset);
+                Term_Format(out, term, Shell_PrintAtom);
+                fprintf(out, ">. %%%f;%f%%\n", imp->truth.frequency, imp->truth.confidence);
+                answered = true;
+                break;
+            }
+        }
+    }
+    if(!answered)
+    {
+        fputs("Answer: None.\n", out);
+    }
+}
+
+bool Shell_Execute(Shell_Command *command, FILE *out)
+{
+    shell_out = out;
+    Term term;
+    switch(command->type)
+    {
+        case SHELL_EMPTY:
+            return true;
+        case SHELL_BELIEF:
+            if(!Shell_Term(command->name, &term, true))
+            {
+                return false;
+            }
+            MSC_AddInput(term, EVENT_TYPE_BELIEF, command->truth, Shell_OperationID(&term));
+            return true;
+        case SHELL_GOAL:
+            if(!Shell_Term(command->name, &term, true))
+            {
+                return false;
+            }
+            MSC_AddInput(term, EVENT_TYPE_GOAL, command->truth, 0);
+            return true;
+        case SHELL_QUESTION:
+            //an unknown name has no concept to answer from
+            Shell_Answer(Shell_Term(command->name, &term, false) ? &term : NULL, out);
+            return true;
+        case SHELL_CYCLES:
+            MSC_AdvanceTime(command->cycles);
+            return true;
+        case SHELL_OPERATION:
+        {
+            //the last table belongs to the last operation
+            int registered = 0;
+            while(registered < OPERATIONS_MAX-1 && Memory_OperationRegistered(registered))
+            {
+                registered++;
+            }
+            if(command->name[0] != '^' || registered == OPERATIONS_MAX-1 || !Shell_Term(command->name, &term, true) || Shell_OperationID(&term) != 0)
+            {
+                return false;
+            }
+            MSC_AddOperationWithContext(term, Shell_Executed, terms[(unsigned char) term.terms[0] - 1]);
+            return true;
+        }
+        case SHELL_RESET:
+            MSC_INIT();
+            return true;
+        case SHELL_TIME:
+            fprintf(out, "time=%ld\n", currentTime);
+            return true;
+        case SHELL_CONCEPTS:
+            fprintf(out, "concepts=%d\n", concepts.itemsAmount);
+            return true;
+        case SHELL_SAVE:
+            return MSC_Save(command->name);
+        case SHELL_LOAD:
+            return MSC_Load(command->name);
+        case SHELL_GRAPH:
+        {
+            //written while the next lines are executed, so a failed write is answered with a later line
+            bool written = Graph_Wait();
+            return MSC_ExportGraph(command->name, Graph_Format(command->name)) && written;
+        }
+    }
+    return false;
+}
+
+static bool Shell_Line(char *line, FILE *out)
+{
+    Shell_Command command;
+    shell_line++;
+    if(!Shell_Parse(line, &command) || !Shell_Execute(&command, out))
+    {
+        fprintf(out, "Error: line %ld\n", shell_line);
+        return false;
+    }
+    return true;
+}
+
+long Shell_Run(FILE *in, FILE *out)
+{
+    static char buffer[SHELL_BUFFER_SIZE];
+    long failed = 0;
+    size_t amount = 0;
+    bool overlong = false;
+    shell_line = 0;
+    //the decisions are only answered through the operations, so their lines don't mix with the answers,
+    //the level being restored after the session
+    int decisionLevel = EVENTLOG_LEVEL[EVENTLOG_DECISION];
+    EVENTLOG_LEVEL[EVENTLOG_DECISION] = EVENTLOG_OFF;
+    //read returns what a pipe holds, so a simulator waiting for the answers isn't waited for in turn
+    for(;;)
+    {
+        fflush(out);
+        ssize_t got = read(fileno(in), buffer + amount, SHELL_BUFFER_SIZE - 1 - amount);
+        if(got <= 0)
+        {
+            break;
+        }
+        amount += got;
+        char *line = buffer;
+        char *end;
+        while((end = memchr(line, '\n', buffer + amount - line)) != NULL)
+        {
+            *end = 0;
+            if(overlong)
+            {
+                //the rest of a line which didn't fit the buffer
+                overlong = false;
+                fprintf(out, "Error: line %ld\n", ++shell_line);
+                failed++;
+            }
+            else if(!Shell_Line(line, out))
+            {
+                failed++;
+            }
+            line = end+1;
+        }
+        amount -= line - buffer;
+        memmove(buffer, line, amount);
+        if(amount == SHELL_BUFFER_SIZE - 1)
+        {
+            overlong = true;
+            amount = 0;
+        }
+    }
+    //a last line without newline
+    if(amount > 0 || overlong)
+    {
+        buffer[amount] = 0;
+        if(overlong || !Shell_Line(buffer, out))
+        {
+            failed++;
+        }
+    }
+    if(!Graph_Wait())
+    {
+        fprintf(out, "Error: line %ld\n", shell_line);
+        failed++;
+    }
+    EVENTLOG_LEVEL[EVENTLOG_DECISION] = decisionLevel;
+    fflush(out);
+    return failed;
+}
@@ -0,0 +1,66 @@
+#ifndef H_SHELL
+#define H_SHELL
+
+///////////////////
+//  MSC Shell    //
+///////////////////
+//Line protocol to drive MSC from another process through pipes. Each line is one of:
+//  name. [%f;c%]      belief event, with the default truth if none is given (^op. for operation feedback)
+//  name! [%f;c%]      goal event
+//  name?              question, answered with the best valid implication predicting name per operation
+//  N                  run N cycles
+//  *op ^name          register an operation, whose execution is answered as "^name executed"
+//  *reset             reset the system, the operations have to be registered again
+//  *time, *concepts   answered as "time=N" and "concepts=N"
+//  *save path, *load path
+//  *graph path        export the implication graph, as JSON lines for a .json or .jsonl path, DOT otherwise,
+//                     written in the background, a failed write being answered with the next *graph or last line
+//  // comment
+//Answers and errors ("Error: ...") go to the output, which is flushed whenever more input is awaited.
+//The decision lines are not logged during a session, only the executions being answered.
+//Lines are parsed in place from a fixed buffer, and names are only copied when first encoded. A name longer than
+//TERMS_LEN, or a new one once TERMS_ENCODABLE names are encoded, fails its line.
+
+//References//
+//-----------//
+#include <ctype.h>
+#include "MSC.h"
+#include "Encode.h"
+
+//Parameters//
+//----------//
+#define SHELL_BUFFER_SIZE 65536
+
+//Data structure//
+//--------------//
+#define SHELL_EMPTY 0
+#define SHELL_BELIEF 1
+#define SHELL_GOAL 2
+#define SHELL_QUESTION 3
+#define SHELL_CYCLES 4
+#define SHELL_OPERATION 5
+#define SHELL_RESET 6
+#define SHELL_TIME 7
+#define SHELL_CONCEPTS 8
+#define SHELL_SAVE 9
+#define SHELL_LOAD 10
+#define SHELL_GRAPH 11
+typedef struct
+{
+    int type;
+    //the name of an event, question or operation, or the path, pointing into the line
+    char *name;
+    Truth truth;
+    long cycles;
+} Shell_Command;
+
+//Methods//
+//-------//
+//Parse a line without its newline, terminating the name within it, false on a syntax error
+bool Shell_Parse(char *line, Shell_Command *command);
+//Execute a parsed command, writing answers to out, false if it couldn't be executed
+bool Shell_Execute(Shell_Command *command, FILE *out);
+//Execute the lines of in until its end, returning the amount of lines which failed
+long Shell_Run(FILE *in, FILE *out);
+
+#endif
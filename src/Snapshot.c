@@ -0,0 +1,385 @@
+#include "Snapshot.h"
+
+//the state of an image besides the concepts, taken from the reasoner to be written,
+//and read completely before it replaces the state of the reasoner
+typedef struct
+{
+    long currentTime;
+    long base;
+    int stampID;
+    int conceptId;
+    long conceptGeneration;
+    int operationsIndex;
+    int termsAmount;
+    char terms[TERMS_MAX][TERMS_LEN+1];
+    Term operations[OPERATIONS_MAX];
+    int itemsAmount;
+    bool modified;
+    double priorities[CONCEPTS_MAX];
+    int itemSlots[CONCEPTS_MAX];
+    FIFO beliefEvents;
+    FIFO goalEvents;
+    AnticipationWheel wheel;
+    int wheelSlots[ANTICIPATIONS_MAX];
+} Snapshot_Image;
+static Snapshot_Image snapshot_image;
+//the concepts are too large to be staged as a whole, so the image is validated through this one first
+static Concept snapshot_concept;
+//names of the terms of the loaded images
+static char snapshot_terms[TERMS_MAX][TERMS_LEN+1];
+
+//the fields an image can only be read with if they match
+static const int snapshot_layout[] = { sizeof(Concept), sizeof(Implication), sizeof(Event), sizeof(FIFO),
+                                       sizeof(AnticipationWheel), sizeof(long), CONCEPTS_MAX, OPERATIONS_MAX,
+                                       TABLE_SIZE, TERMS_MAX };
+
+static bool Snapshot_Header(FILE *file, bool write)
+{
+    return Binary_Header(file, write, "MSCSNAP", SNAPSHOT_VERSION, snapshot_layout, sizeof(snapshot_layout) / sizeof(int));
+}
+
+//pointers into concept storage are stored as slot, -1 for none
+static int Snapshot_SlotOf(void *concept)
+{
+    return concept == NULL ? -1 : Memory_ConceptSlot(concept);
+}
+
+static bool Snapshot_ValidSlot(int slot)
+{
+    return slot >= -1 && slot < CONCEPTS_MAX;
+}
+
+static Concept *Snapshot_ConceptAt(int slot)
+{
+    return slot < 0 ? NULL : &concept_storage[slot];
+}
+
+static bool Snapshot_Terms(FILE *file, bool write, Snapshot_Image *image)
+{
+    if(!TRANSFER(image->termsAmount) || image->termsAmount < 0 || image->termsAmount > TERMS_MAX)
+    {
+        return false;
+    }
+    for(int i=0; i<image->termsAmount; i++)
+    {
+        char *name = image->terms[i];
+        int length = write ? (int) strlen(name) : 0;
+        if(!TRANSFER(length) || length < 0 || length > TERMS_LEN || (length > 0 && !Binary_Transfer(file, write, name, length)))
+        {
+            return false;
+        }
+        name[length] = 0;
+    }
+    return true;
+}
+
+static bool Snapshot_Concept(FILE *file, bool write, Concept *c)
+{
+    if(!(TRANSFER(c->id) && TRANSFER(c->generation) && TRANSFER(c->usage) && TRANSFER(c->term) &&
+         TRANSFER(c->belief_spike) && TRANSFER(c->incoming_goal_spike) && TRANSFER(c->goal_spike)))
+    {
+        return false;
+    }
+#ifndef MSC_LEAN
+    if(!TRANSFER(c->debug))
+    {
+        return false;
+    }
+#endif
+    //the planner's marks are only compared within one search
+    if(!write)
+    {
+        c->planner_search = 0;
+    }
+    //only the used part of the tables
+    for(int opi=0; opi<OPERATIONS_MAX; opi++)
+    {
+        Table *table = &c->precondition_beliefs[opi];
+        if(!TRANSFER(table->itemsAmount) || !TRANSFER(table->version) || table->itemsAmount < 0 || table->itemsAmount > TABLE_SIZE)
+        {
+            return false;
+        }
+        //the source concepts are slots already
+        if(table->itemsAmount > 0 && !Binary_Transfer(file, write, table->array, table->itemsAmount * sizeof(Implication)))
+        {
+            return false;
+        }
+        for(int j=0; j<table->itemsAmount; j++)
+        {
+            if(table->array[j].sourceConcept < 0 || table->array[j].sourceConcept >= CONCEPTS_MAX)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//the concepts from or into storage, or only validated if it's NULL
+static bool Snapshot_Concepts(FILE *file, bool write, Snapshot_Image *image, Concept *storage)
+{
+    //the whole queue, as the slots behind its items decide where new concepts go
+    if(!TRANSFER(image->itemsAmount) || !TRANSFER(image->modified) || image->itemsAmount < 0 || image->itemsAmount > CONCEPTS_MAX)
+    {
+        return false;
+    }
+    //each slot is behind exactly one item
+    static bool itemSlotSeen[CONCEPTS_MAX];
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        itemSlotSeen[i] = false;
+    }
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        if(!TRANSFER(image->priorities[i]) || !TRANSFER(image->itemSlots[i]) || image->itemSlots[i] < 0 || image->itemSlots[i] >= CONCEPTS_MAX ||
+           (!write && itemSlotSeen[image->itemSlots[i]]))
+        {
+            return false;
+        }
+        itemSlotSeen[image->itemSlots[i]] = true;
+    }
+    //an evicted concept stays in its slot until it is reused, and implications still check it then,
+    //so every slot a concept ever entered is kept, the others being left empty
+    int used = 0;
+    for(int slot=0; write && slot<CONCEPTS_MAX; slot++)
+    {
+        used += storage[slot].generation != 0;
+    }
+    if(!TRANSFER(used) || used < 0 || used > CONCEPTS_MAX)
+    {
+        return false;
+    }
+    int next = 0;
+    for(int i=0; i<used; i++)
+    {
+        int slot = next;
+        while(write && storage[slot].generation == 0)
+        {
+            slot++;
+        }
+        if(!TRANSFER(slot) || slot < next || slot >= CONCEPTS_MAX)
+        {
+            return false;
+        }
+        for(; !write && storage != NULL && next<slot; next++)
+        {
+            if(storage[next].generation != 0)
+            {
+                storage[next] = (Concept) {0};
+            }
+        }
+        if(!Snapshot_Concept(file, write, storage == NULL ? &snapshot_concept : &storage[slot]))
+        {
+            return false;
+        }
+        next = slot+1;
+    }
+    for(; !write && storage != NULL && next<CONCEPTS_MAX; next++)
+    {
+        if(storage[next].generation != 0)
+        {
+            storage[next] = (Concept) {0};
+        }
+    }
+    return true;
+}
+
+//links are index+1 into the pool, 0 for none
+static bool Snapshot_ValidLink(int link)
+{
+    return link >= 0 && link <= ANTICIPATIONS_MAX;
+}
+
+//a list from head via next or conceptNext ends within the pool, so a cycle is rejected
+static bool Snapshot_ValidList(AnticipationWheel *wheel, int head, bool concept)
+{
+    int steps = 0;
+    for(int i=head; i!=0; i=concept ? wheel->pool[i-1].conceptNext : wheel->pool[i-1].next)
+    {
+        if(++steps > ANTICIPATIONS_MAX)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//every index the wheel follows stays within its arrays
+static bool Snapshot_ValidWheel(Snapshot_Image *image)
+{
+    AnticipationWheel *wheel = &image->wheel;
+    if(!Snapshot_ValidLink(wheel->free) || wheel->amount < 0 || wheel->amount > ANTICIPATIONS_MAX)
+    {
+        return false;
+    }
+    for(int i=0; i<ANTICIPATIONS_MAX; i++)
+    {
+        Anticipation *a = &wheel->pool[i];
+        if(!Snapshot_ValidSlot(image->wheelSlots[i]) || !Snapshot_ValidLink(a->prev) || !Snapshot_ValidLink(a->next) ||
+           !Snapshot_ValidLink(a->conceptPrev) || !Snapshot_ValidLink(a->conceptNext) || a->slot < 0 || a->slot >= ANTICIPATION_WHEEL_SIZE ||
+           a->operationID < 0 || a->operationID >= OPERATIONS_MAX)
+        {
+            return false;
+        }
+    }
+    if(!Snapshot_ValidList(wheel, wheel->free, false))
+    {
+        return false;
+    }
+    for(int i=0; i<ANTICIPATION_WHEEL_SIZE; i++)
+    {
+        if(!Snapshot_ValidLink(wheel->slots[i]) || !Snapshot_ValidList(wheel, wheel->slots[i], false))
+        {
+            return false;
+        }
+    }
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        if(!Snapshot_ValidLink(wheel->conceptHeads[i]) || !Snapshot_ValidList(wheel, wheel->conceptHeads[i], true))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool Snapshot_Anticipations(FILE *file, bool write, Snapshot_Image *image)
+{
+    return TRANSFER(image->wheel) && TRANSFER(image->wheelSlots) && (write || Snapshot_ValidWheel(image));
+}
+
+//the state besides the concepts, which follow it
+static bool Snapshot_State(FILE *file, bool write, Snapshot_Image *image)
+{
+    return TRANSFER(image->currentTime) && TRANSFER(image->base) && TRANSFER(image->stampID) && TRANSFER(image->conceptId) &&
+           TRANSFER(image->conceptGeneration) && TRANSFER(image->operationsIndex) && Snapshot_Terms(file, write, image) &&
+           TRANSFER(image->operations) && TRANSFER(image->beliefEvents) && TRANSFER(image->goalEvents) &&
+           Snapshot_Anticipations(file, write, image);
+}
+
+//the state of the reasoner besides the concepts, with the concepts it points to as slots
+static void Snapshot_Take(Snapshot_Image *image, long currentTime)
+{
+    image->currentTime = currentTime;
+    image->base = base;
+    image->stampID = stampID;
+    image->conceptId = concept_id;
+    image->conceptGeneration = concept_generation;
+    image->operationsIndex = operations_index;
+    image->termsAmount = term_index;
+    for(int i=0; i<term_index; i++)
+    {
+        strcpy(image->terms[i], terms[i]);
+    }
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        image->operations[i] = operations[i].term;
+    }
+    image->itemsAmount = concepts.itemsAmount;
+    image->modified = concepts.modified;
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        image->priorities[i] = concepts.items[i].priority;
+        image->itemSlots[i] = Memory_ConceptSlot(concepts.items[i].address);
+    }
+    image->beliefEvents = belief_events;
+    image->goalEvents = goal_events;
+    image->wheel = anticipations;
+    for(int i=0; i<ANTICIPATIONS_MAX; i++)
+    {
+        image->wheelSlots[i] = Snapshot_SlotOf(image->wheel.pool[i].postcondition);
+        image->wheel.pool[i].postcondition = NULL;
+    }
+}
+
+//replace the state of the reasoner besides the concepts with the image
+static void Snapshot_Install(Snapshot_Image *image, long *currentTime)
+{
+    *currentTime = image->currentTime;
+    base = image->base;
+    stampID = image->stampID;
+    concept_id = image->conceptId;
+    concept_generation = image->conceptGeneration;
+    operations_index = image->operationsIndex;
+    //the names which stay at their index keep their storage, as a registered operation may refer to it
+    for(int i=0; i<image->termsAmount; i++)
+    {
+        if(i >= term_index || strcmp(terms[i], image->terms[i]))
+        {
+            strcpy(snapshot_terms[i], image->terms[i]);
+            terms[i] = snapshot_terms[i];
+        }
+    }
+    term_index = image->termsAmount;
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        operations[i] = (Operation) { .term = image->operations[i] };
+    }
+    concepts.itemsAmount = image->itemsAmount;
+    concepts.modified = image->modified;
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        concepts.items[i] = (Item) { .priority = image->priorities[i], .address = &concept_storage[image->itemSlots[i]] };
+    }
+    belief_events = image->beliefEvents;
+    goal_events = image->goalEvents;
+    anticipations = image->wheel;
+    for(int i=0; i<ANTICIPATIONS_MAX; i++)
+    {
+        anticipations.pool[i].postcondition = Snapshot_ConceptAt(image->wheelSlots[i]);
+    }
+}
+
+bool Snapshot_Write(FILE *file, long currentTime)
+{
+    bool write = true;
+    Snapshot_Take(&snapshot_image, currentTime);
+    return Snapshot_Header(file, write) && Snapshot_State(file, write, &snapshot_image) &&
+           Snapshot_Concepts(file, write, &snapshot_image, concept_storage);
+}
+
+bool Snapshot_ReadHeader(FILE *file)
+{
+    return Snapshot_Header(file, false);
+}
+
+bool Snapshot_Read(FILE *file, long *currentTime)
+{
+    //nothing is replaced before the whole image was read into the staging copy and validated,
+    //only the concepts then being read again into place
+    if(!Snapshot_State(file, false, &snapshot_image))
+    {
+        return false;
+    }
+    long start = ftell(file);
+    if(start < 0 || !Snapshot_Concepts(file, false, &snapshot_image, NULL) || fseek(file, start, SEEK_SET) != 0 ||
+       !Snapshot_Concepts(file, false, &snapshot_image, concept_storage))
+    {
+        return false;
+    }
+    //the callbacks are found by name, as the image brings its own dictionary
+    static char names[OPERATIONS_MAX][TERMS_LEN+1];
+    Operation registered[OPERATIONS_MAX];
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        registered[i] = operations[i];
+        int number = operations[i].term.terms[0];
+        strcpy(names[i], Memory_OperationRegistered(i) && number > 0 && number <= term_index ? terms[number-1] : "");
+    }
+    Snapshot_Install(&snapshot_image, currentTime);
+    for(int i=0; i<OPERATIONS_MAX; i++)
+    {
+        int number = operations[i].term.terms[0];
+        for(int j=0; number > 0 && number <= term_index && j<OPERATIONS_MAX; j++)
+        {
+            if(names[j][0] != 0 && !strcmp(names[j], terms[number-1]))
+            {
+                operations[i].action = registered[j].action;
+                operations[i].contextAction = registered[j].contextAction;
+                operations[i].user = registered[j].user;
+                break;
+            }
+        }
+    }
+    return true;
+}
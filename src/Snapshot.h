@@ -0,0 +1,38 @@
+#ifndef H_SNAPSHOT
+#define H_SNAPSHOT
+
+///////////////////////
+//  MSC Snapshot     //
+///////////////////////
+//Binary image of the reasoner state: the concepts with their tables, the order of
+//the concept queue, both FIFOs, the scheduled anticipations, the operations (by term),
+//the term dictionary and the time and stamp counters. Concept pointers are stored as
+//storage slots and everything else as laid out in memory, so an image can only be
+//loaded by a build with the same version and layout, which the header records.
+//Version 2: implications refer to their source concept by slot.
+//Version 3: the stamp counter of the negative evidence.
+//Version 4: the concepts follow the rest of the state.
+
+//References//
+//-----------//
+#include "Decision.h"
+#include "Encode.h"
+#include "Binary.h"
+
+//Parameters//
+//----------//
+#define SNAPSHOT_VERSION 4
+
+//Methods//
+//-------//
+//Write the state at currentTime, false on a write error
+bool Snapshot_Write(FILE *file, long currentTime);
+//Whether the file continues with a header of this version and layout, leaving the state untouched
+bool Snapshot_ReadHeader(FILE *file);
+//Replace the state with the one following the header, false if the image ends early or is corrupt, in which
+//case the state is left untouched, as the image is validated completely before it's read into place.
+//The file has to be seekable.
+//Registered operations keep their callbacks where the image has an operation of the same name.
+bool Snapshot_Read(FILE *file, long *currentTime);
+
+#endif
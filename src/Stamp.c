@@ -70,6 +70,20 @@ bool Stamp_checkOverlap(Stamp *a, Stamp *b)
     return false;
 }
 
+uint64_t Stamp_signature(Stamp *stamp)
+{
+    uint64_t signature = 0;
+    for(int i=0; i<STAMP_SIZE; i++)
+    {
+        if(stamp->evidentalBase[i] == STAMP_FREE)
+        {
+            break;
+        }
+        signature |= ((uint64_t) 1) << (((uint64_t) stamp->evidentalBase[i]) & 63);
+    }
+    return signature;
+}
+
 void Stamp_print(Stamp *stamp)
 {
     fputs("stamp=", stdout);
@@ -10,6 +10,7 @@
 //----------//
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdint.h>
 
 //Parameters//
 //----------//
@@ -30,6 +31,8 @@ typedef struct {
 Stamp Stamp_make(Stamp *stamp1, Stamp *stamp2);
 //true iff there is evidental base overlap between a and b
 bool Stamp_checkOverlap(Stamp *a, Stamp *b);
+//bit signature of the evidental base, stamps with disjoint signatures can't overlap
+uint64_t Stamp_signature(Stamp *stamp);
 //print stamp
 void Stamp_print(Stamp *stamp);
 
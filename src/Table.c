@@ -18,6 +18,7 @@ Implication *Table_Add(Table *table, Implication *imp)
             }
             table->array[i] = *imp;
             table->itemsAmount = MIN(table->itemsAmount+1, TABLE_SIZE);
+            table->version++;
             return &table->array[i];
         }
     }
@@ -32,6 +33,7 @@ void Table_Remove(Table *table, int index)
         table->array[j] = j == table->itemsAmount-1 ? (Implication) {0} : table->array[j+1];
     }
     table->itemsAmount = MAX(0, table->itemsAmount-1);
+    table->version++;
 }
 
 static void Table_SantiyCheck(Table *table)
@@ -51,6 +53,7 @@ static void Table_SantiyCheck(Table *table)
 Implication *Table_AddAndRevise(Table *table, Implication *imp, char *debug)
 {
     IN_DEBUG ( Table_SantiyCheck(table); )
+    (void) debug; //not stored in a lean build
     //1. find element with same Term
     int same_i = -1;
     for(int i=0; i<table->itemsAmount; i++)
@@ -73,7 +76,7 @@ Implication *Table_AddAndRevise(Table *table, Implication *imp, char *debug)
         Implication revised = Inference_ImplicationRevision(&OldImp, imp);
         assert(revised.truth.frequency >= 0.0 && revised.truth.frequency <= 1.0, "(3) frequency out of bounds");
         assert(revised.truth.confidence >= 0.0 && revised.truth.confidence <= 1.0, "(3) confidence out of bounds");
-        strcpy(revised.debug, debug);
+        IN_NAMES( strcpy(revised.debug, debug); )
         Implication_SetTerm(&revised, imp->term);
         //printf("AAA %s  %.02f,%.02f\n", revised.debug, revised.truth.frequency, revised.truth.confidence);
         Table_Remove(table, same_i);
@@ -85,7 +88,7 @@ Implication *Table_AddAndRevise(Table *table, Implication *imp, char *debug)
     else
     {
         //3. add imp too:
-        strcpy(imp->debug, debug);
+        IN_NAMES( strcpy(imp->debug, debug); )
         //printf("ADDED\n");
         return Table_Add(table, imp);
     }
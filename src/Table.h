@@ -23,6 +23,8 @@
 typedef struct {
     Implication array[TABLE_SIZE];
     int itemsAmount;
+    //incremented on every change, to validate what was derived from the content
+    long version;
 } Table;
 
 //Methods//
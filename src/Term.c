@@ -12,6 +12,26 @@ void Term_Print(Term *term)
     puts("===");
 }
 
+void Term_Format(FILE *out, Term *term, Term_Atom atom)
+{
+    int amount = 0;
+    for(int i=0; i<MAX_SEQUENCE_LEN; i++)
+    {
+        amount += term->terms[i] != 0;
+    }
+    fputs(amount > 1 ? "(&/," : "", out);
+    for(int i=0, printed=0; i<MAX_SEQUENCE_LEN; i++)
+    {
+        int number = (unsigned char) term->terms[i];
+        if(number != 0)
+        {
+            fputs(printed++ ? "," : "", out);
+            atom(out, number);
+        }
+    }
+    fputs(amount > 1 ? ")" : "", out);
+}
+
 Term Term_Sequence(Term *a, Term *b)
 {
     Term ret = {0};
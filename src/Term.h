@@ -28,11 +28,15 @@ typedef struct
 {
     char terms[MAX_SEQUENCE_LEN];
 }Term;
+//Writes the atomic term numbered number (from 1), its name or a stand-in
+typedef void (*Term_Atom)(FILE *out, int number);
 
 //Methods//
 //-------//
 // print indices of true bits
 void Term_Print(Term *term);
+//Writes the term as in Narsese, an atom or a sequence (&/,a,b), each atom written by atom
+void Term_Format(FILE *out, Term *term, Term_Atom atom);
 //Tuple on the other hand:
 Term Term_Sequence(Term *a, Term *b);
 //Whether two Term's are equal completely
@@ -0,0 +1,191 @@
+#include "Trace.h"
+
+long trace_position = 0;
+bool trace_diverged = false;
+
+static FILE *trace_file = NULL;
+static FILE *trace_replay = NULL;
+static bool trace_failed = false;
+static long trace_cycles = 0;
+
+//the fields a trace can only be replayed with if they match
+static const int trace_layout[] = { sizeof(Term), sizeof(Truth), sizeof(long) };
+
+static bool Trace_Header(FILE *file, bool write)
+{
+    return Binary_Header(file, write, "MSCTRCE", TRACE_VERSION, trace_layout, sizeof(trace_layout) / sizeof(int));
+}
+
+static bool Trace_Fields(FILE *file, bool write, Trace_Record *record)
+{
+    switch(record->type)
+    {
+        case TRACE_INIT:
+            return true;
+        case TRACE_OPERATION:
+            return TRANSFER(record->term);
+        case TRACE_INPUT:
+            return TRANSFER(record->term) && TRANSFER(record->eventType) && TRANSFER(record->truth) &&
+                   TRANSFER(record->operationID) && TRANSFER(record->iterations);
+        case TRACE_CYCLES:
+        case TRACE_SKIP:
+            return TRANSFER(record->cycles);
+        case TRACE_RANDOM:
+        case TRACE_DECISION:
+            return TRANSFER(record->value);
+    }
+    return false;
+}
+
+static void Trace_Put(Trace_Record *record)
+{
+    bool write = true;
+    FILE *file = trace_file;
+    if(!TRANSFER(record->type) || !Trace_Fields(file, write, record))
+    {
+        trace_failed = true;
+    }
+}
+
+//the cycles run since the last record
+static void Trace_FlushCycles(void)
+{
+    if(trace_cycles > 0)
+    {
+        Trace_Record cycles = { .type = TRACE_CYCLES, .cycles = trace_cycles };
+        trace_cycles = 0;
+        Trace_Put(&cycles);
+    }
+}
+
+bool Trace_Start(const char *path)
+{
+    Trace_Stop();
+    trace_file = fopen(path, "wb");
+    if(trace_file == NULL)
+    {
+        return false;
+    }
+    trace_failed = false;
+    trace_cycles = 0;
+    trace_failed = !Trace_Header(trace_file, true);
+    return !trace_failed;
+}
+
+bool Trace_Stop(void)
+{
+    if(trace_file == NULL)
+    {
+        return true;
+    }
+    Trace_FlushCycles();
+    bool written = fclose(trace_file) == 0 && !trace_failed;
+    trace_file = NULL;
+    return written;
+}
+
+bool Trace_Recording(void)
+{
+    return trace_file != NULL;
+}
+
+void Trace_Write(Trace_Record *record)
+{
+    if(trace_file != NULL)
+    {
+        Trace_FlushCycles();
+        Trace_Put(record);
+    }
+}
+
+void Trace_Cycle(void)
+{
+    if(trace_file != NULL)
+    {
+        trace_cycles++;
+    }
+}
+
+//the next record while replaying, which has to be of the type, diverging otherwise
+static bool Trace_Expect(char type, Trace_Record *record)
+{
+    if(trace_diverged || !Trace_Next(record) || record->type != type)
+    {
+        trace_diverged = true;
+        return false;
+    }
+    return true;
+}
+
+int Trace_Rand(void)
+{
+    Trace_Record record;
+    if(trace_replay != NULL)
+    {
+        //after diverging the reasoner continues with its own draws
+        return Trace_Expect(TRACE_RANDOM, &record) ? record.value : rand();
+    }
+    int value = rand();
+    if(trace_file != NULL)
+    {
+        record = (Trace_Record) { .type = TRACE_RANDOM, .value = value };
+        Trace_Write(&record);
+    }
+    return value;
+}
+
+void Trace_Decision(int operationID)
+{
+    Trace_Record record;
+    if(trace_replay != NULL)
+    {
+        if(Trace_Expect(TRACE_DECISION, &record) && record.value != operationID)
+        {
+            trace_diverged = true;
+        }
+        return;
+    }
+    record = (Trace_Record) { .type = TRACE_DECISION, .value = operationID };
+    Trace_Write(&record);
+}
+
+bool Trace_OpenReplay(const char *path)
+{
+    Trace_CloseReplay();
+    trace_position = 0;
+    trace_diverged = false;
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return false;
+    }
+    if(!Trace_Header(file, false))
+    {
+        fclose(file);
+        return false;
+    }
+    trace_replay = file;
+    return true;
+}
+
+bool Trace_Next(Trace_Record *record)
+{
+    bool write = false;
+    FILE *file = trace_replay;
+    *record = (Trace_Record) {0};
+    if(file == NULL || !TRANSFER(record->type) || !Trace_Fields(file, write, record))
+    {
+        return false;
+    }
+    trace_position++;
+    return true;
+}
+
+void Trace_CloseReplay(void)
+{
+    if(trace_replay != NULL)
+    {
+        fclose(trace_replay);
+        trace_replay = NULL;
+    }
+}
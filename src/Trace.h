@@ -0,0 +1,79 @@
+#ifndef H_TRACE
+#define H_TRACE
+
+///////////////////
+//  MSC Trace    //
+///////////////////
+//Binary record of what drives the reasoner: resets, operation registrations, inputs
+//from outside, runs of cycles and skipped idle cycles, together with the random draws
+//and decisions of the reasoner. Replaying a trace feeds the recorded draws back and
+//checks each decision against the recorded one, so an engine change which alters
+//behaviour is caught at the first decision or draw that differs. The file starts with
+//the header of Binary.h, recording TRACE_VERSION and the sizes of Term, Truth and long.
+
+//References//
+//-----------//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Globals.h"
+#include "Binary.h"
+#include "Term.h"
+#include "Truth.h"
+
+//Parameters//
+//----------//
+#define TRACE_VERSION 1
+
+//Data structure//
+//--------------//
+#define TRACE_INIT 1
+#define TRACE_OPERATION 2
+#define TRACE_INPUT 3
+#define TRACE_CYCLES 4
+#define TRACE_SKIP 5
+#define TRACE_RANDOM 6
+#define TRACE_DECISION 7
+typedef struct
+{
+    char type;
+    //TRACE_OPERATION and TRACE_INPUT
+    Term term;
+    //TRACE_INPUT: the event, and the propagation iterations it was added with
+    char eventType;
+    Truth truth;
+    int operationID;
+    int iterations;
+    //TRACE_CYCLES and TRACE_SKIP: the amount of cycles run or skipped
+    long cycles;
+    //TRACE_RANDOM: the drawn number, TRACE_DECISION: the operationID decided for
+    int value;
+} Trace_Record;
+//records read while replaying, and whether the reasoner diverged from them
+extern long trace_position;
+extern bool trace_diverged;
+
+//Methods//
+//-------//
+//Start recording to the file, false if it can't be written
+bool Trace_Start(const char *path);
+//Write the remaining records and close the file, false if a record couldn't be written
+bool Trace_Stop(void);
+//Whether a trace is recorded
+bool Trace_Recording(void);
+//Record a reset, operation registration, input or skip
+void Trace_Write(Trace_Record *record);
+//Record a cycle, runs of which are written as one record
+void Trace_Cycle(void);
+//rand() for the reasoner: recorded, or the recorded draw while replaying
+int Trace_Rand(void);
+//Record a decision, or check it against the recorded one while replaying
+void Trace_Decision(int operationID);
+//Start replaying the file, false if it isn't a trace of this version and layout
+bool Trace_OpenReplay(const char *path);
+//The next record to replay, false at the end of the trace or at a record cut short
+bool Trace_Next(Trace_Record *record);
+//Stop replaying
+void Trace_CloseReplay(void);
+
+#endif
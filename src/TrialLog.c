@@ -0,0 +1,273 @@
+#include "TrialLog.h"
+
+//the fields a log can only be read with if they match
+static const int triallog_layout[] = { sizeof(int), sizeof(double) };
+
+static bool TrialLog_Header(FILE *file, bool write, int *columnsAmount)
+{
+    return Binary_Header(file, write, "MSCCOLS", TRIALLOG_VERSION, triallog_layout, sizeof(triallog_layout) / sizeof(int)) &&
+           TRANSFER(*columnsAmount);
+}
+
+static void TrialLog_Write(TrialLog *log, const void *data, size_t size, size_t amount)
+{
+    if(amount > 0 && fwrite(data, size, amount, log->file) != amount)
+    {
+        log->failed = true;
+    }
+}
+
+bool TrialLog_Open(TrialLog *log, const char *path, const TrialLog_Column *columns, int columnsAmount, bool binary)
+{
+    assert(columnsAmount > 0 && columnsAmount <= TRIALLOG_COLUMNS_MAX, "TrialLog: too many columns");
+    log->file = fopen(path, binary ? "wb" : "w");
+    if(log->file == NULL)
+    {
+        return false;
+    }
+    log->binary = binary;
+    log->failed = false;
+    log->columnsAmount = columnsAmount;
+    log->column = log->rows = 0;
+    log->stringsAmount = log->stringsWritten = 0;
+    if(binary && !TrialLog_Header(log->file, true, &columnsAmount))
+    {
+        log->failed = true;
+    }
+    for(int i=0; i<columnsAmount; i++)
+    {
+        size_t length = strlen(columns[i].name);
+        assert(length <= TRIALLOG_NAME_LEN, "TrialLog: column name too long");
+        log->types[i] = columns[i].type;
+        if(binary)
+        {
+            unsigned char byte = length;
+            TrialLog_Write(log, &columns[i].type, 1, 1);
+            TrialLog_Write(log, &byte, 1, 1);
+            TrialLog_Write(log, columns[i].name, 1, length);
+        }
+        else
+        {
+            fprintf(log->file, "%s%c", columns[i].name, i+1 < columnsAmount ? ',' : '\n');
+        }
+    }
+    return !log->failed;
+}
+
+//the new strings and the columns of the buffered rows
+static void TrialLog_WriteBlock(TrialLog *log)
+{
+    int newStrings = log->stringsAmount - log->stringsWritten;
+    TrialLog_Write(log, &newStrings, sizeof(int), 1);
+    for(; log->stringsWritten < log->stringsAmount; log->stringsWritten++)
+    {
+        char *s = log->strings[log->stringsWritten];
+        unsigned char length = strlen(s);
+        TrialLog_Write(log, &length, 1, 1);
+        TrialLog_Write(log, s, 1, length);
+    }
+    TrialLog_Write(log, &log->rows, sizeof(int), 1);
+    for(int i=0; i<log->columnsAmount; i++)
+    {
+        if(log->types[i] == TRIALLOG_DOUBLE)
+        {
+            TrialLog_Write(log, log->reals[i], sizeof(double), log->rows);
+        }
+        else
+        {
+            TrialLog_Write(log, log->integers[i], sizeof(int), log->rows);
+        }
+    }
+    log->rows = 0;
+}
+
+//the cell was added, which ends the row after the last column
+static void TrialLog_NextCell(TrialLog *log)
+{
+    if(++log->column < log->columnsAmount)
+    {
+        if(!log->binary)
+        {
+            fputc(',', log->file);
+        }
+        return;
+    }
+    log->column = 0;
+    if(!log->binary)
+    {
+        fputc('\n', log->file);
+    }
+    else if(++log->rows == TRIALLOG_BLOCK_ROWS)
+    {
+        TrialLog_WriteBlock(log);
+    }
+}
+
+void TrialLog_Int(TrialLog *log, int value)
+{
+    assert(log->types[log->column] == TRIALLOG_INT, "TrialLog: the column isn't an int column");
+    if(log->binary)
+    {
+        log->integers[log->column][log->rows] = value;
+    }
+    else
+    {
+        fprintf(log->file, "%d", value);
+    }
+    TrialLog_NextCell(log);
+}
+
+void TrialLog_Double(TrialLog *log, double value)
+{
+    assert(log->types[log->column] == TRIALLOG_DOUBLE, "TrialLog: the column isn't a double column");
+    if(log->binary)
+    {
+        log->reals[log->column][log->rows] = value;
+    }
+    else
+    {
+        fprintf(log->file, "%.6f", value);
+    }
+    TrialLog_NextCell(log);
+}
+
+void TrialLog_String(TrialLog *log, const char *value)
+{
+    assert(log->types[log->column] == TRIALLOG_STRING, "TrialLog: the column isn't a string column");
+    if(log->binary)
+    {
+        int index = 0;
+        while(index < log->stringsAmount && strcmp(log->strings[index], value))
+        {
+            index++;
+        }
+        if(index == log->stringsAmount)
+        {
+            if(index == TRIALLOG_STRINGS_MAX || strlen(value) > TRIALLOG_NAME_LEN)
+            {
+                //the row can't be read back, so the log is incomplete
+                log->failed = true;
+                index = 0;
+            }
+            else
+            {
+                strcpy(log->strings[log->stringsAmount++], value);
+            }
+        }
+        log->integers[log->column][log->rows] = index;
+    }
+    else
+    {
+        fputs(value, log->file);
+    }
+    TrialLog_NextCell(log);
+}
+
+bool TrialLog_Close(TrialLog *log)
+{
+    if(log->file == NULL)
+    {
+        return false;
+    }
+    if(log->binary && log->rows > 0)
+    {
+        TrialLog_WriteBlock(log);
+    }
+    bool written = fclose(log->file) == 0 && !log->failed && log->column == 0;
+    log->file = NULL;
+    return written;
+}
+
+static bool TrialLog_Read(FILE *file, void *data, size_t size, size_t amount)
+{
+    return fread(data, size, amount, file) == amount;
+}
+
+//the block after its count of new strings, printed as CSV rows
+static bool TrialLog_ReadBlock(FILE *file, TrialLog *log, int newStrings, FILE *csv)
+{
+    if(newStrings < 0 || newStrings > TRIALLOG_STRINGS_MAX - log->stringsAmount)
+    {
+        return false;
+    }
+    for(int i=0; i<newStrings; i++)
+    {
+        unsigned char length;
+        char *s = log->strings[log->stringsAmount++];
+        if(!TrialLog_Read(file, &length, 1, 1) || length > TRIALLOG_NAME_LEN || !TrialLog_Read(file, s, 1, length))
+        {
+            return false;
+        }
+        s[length] = 0;
+    }
+    if(!TrialLog_Read(file, &log->rows, sizeof(int), 1) || log->rows <= 0 || log->rows > TRIALLOG_BLOCK_ROWS)
+    {
+        return false;
+    }
+    for(int i=0; i<log->columnsAmount; i++)
+    {
+        bool real = log->types[i] == TRIALLOG_DOUBLE;
+        if(!TrialLog_Read(file, real ? (void*) log->reals[i] : (void*) log->integers[i], real ? sizeof(double) : sizeof(int), log->rows))
+        {
+            return false;
+        }
+    }
+    for(int row=0; row<log->rows; row++)
+    {
+        for(int i=0; i<log->columnsAmount; i++)
+        {
+            int index = log->integers[i][row];
+            if(log->types[i] == TRIALLOG_DOUBLE)
+            {
+                fprintf(csv, "%.6f", log->reals[i][row]);
+            }
+            else if(log->types[i] == TRIALLOG_INT)
+            {
+                fprintf(csv, "%d", index);
+            }
+            else if(index >= 0 && index < log->stringsAmount)
+            {
+                fputs(log->strings[index], csv);
+            }
+            else
+            {
+                return false;
+            }
+            fputc(i+1 < log->columnsAmount ? ',' : '\n', csv);
+        }
+    }
+    return true;
+}
+
+bool TrialLog_ToCSV(const char *path, FILE *csv)
+{
+    static TrialLog log;
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+    {
+        return false;
+    }
+    int columnsAmount = 0;
+    bool read = TrialLog_Header(file, false, &columnsAmount) && columnsAmount > 0 && columnsAmount <= TRIALLOG_COLUMNS_MAX;
+    log.columnsAmount = read ? columnsAmount : 0;
+    log.stringsAmount = 0;
+    for(int i=0; read && i<log.columnsAmount; i++)
+    {
+        unsigned char length;
+        char name[TRIALLOG_NAME_LEN+1];
+        read = TrialLog_Read(file, &log.types[i], 1, 1) && log.types[i] >= TRIALLOG_INT && log.types[i] <= TRIALLOG_STRING &&
+               TrialLog_Read(file, &length, 1, 1) && length <= TRIALLOG_NAME_LEN && TrialLog_Read(file, name, 1, length);
+        name[read ? length : 0] = 0;
+        if(read)
+        {
+            fprintf(csv, "%s%c", name, i+1 < log.columnsAmount ? ',' : '\n');
+        }
+    }
+    int newStrings;
+    while(read && TrialLog_Read(file, &newStrings, sizeof(int), 1))
+    {
+        read = TrialLog_ReadBlock(file, &log, newStrings, csv);
+    }
+    fclose(file);
+    return read;
+}
@@ -0,0 +1,70 @@
+#ifndef H_TRIALLOG
+#define H_TRIALLOG
+
+////////////////////////
+//  MSC Trial Log     //
+////////////////////////
+//Log of experiment trials, one row of fixed columns per trial, written either as CSV text
+//or in a columnar binary format: a header with the columns, then blocks of up to
+//TRIALLOG_BLOCK_ROWS rows which store each column contiguously as int or double, with
+//string cells as indices into a dictionary extended by the strings first used in the block.
+//Writing a block is a memcpy of its columns, and TrialLog_ToCSV converts it to the same text.
+
+//References//
+//-----------//
+#include <stdio.h>
+#include <string.h>
+#include "Globals.h"
+#include "Binary.h"
+
+//Parameters//
+//----------//
+#define TRIALLOG_VERSION 1
+#define TRIALLOG_COLUMNS_MAX 16
+#define TRIALLOG_BLOCK_ROWS 1024
+#define TRIALLOG_STRINGS_MAX 256
+#define TRIALLOG_NAME_LEN 31
+
+//Data structure//
+//--------------//
+#define TRIALLOG_INT 1
+#define TRIALLOG_DOUBLE 2
+//printed with %.6f like the CSV logs
+#define TRIALLOG_STRING 3
+typedef struct
+{
+    char type;
+    const char *name;
+} TrialLog_Column;
+typedef struct
+{
+    FILE *file;
+    bool binary;
+    bool failed;
+    int columnsAmount;
+    char types[TRIALLOG_COLUMNS_MAX];
+    //the cell of the current row to be added next
+    int column;
+    int rows;
+    int integers[TRIALLOG_COLUMNS_MAX][TRIALLOG_BLOCK_ROWS];
+    double reals[TRIALLOG_COLUMNS_MAX][TRIALLOG_BLOCK_ROWS];
+    char strings[TRIALLOG_STRINGS_MAX][TRIALLOG_NAME_LEN+1];
+    int stringsAmount;
+    //the strings already written to the file
+    int stringsWritten;
+} TrialLog;
+
+//Methods//
+//-------//
+//Start a log of the columns, as CSV text with a header line or in the binary format, false if it can't be written
+bool TrialLog_Open(TrialLog *log, const char *path, const TrialLog_Column *columns, int columnsAmount, bool binary);
+//Add the next cell of the current row, in the order of the columns
+void TrialLog_Int(TrialLog *log, int value);
+void TrialLog_Double(TrialLog *log, double value);
+void TrialLog_String(TrialLog *log, const char *value);
+//Write the remaining rows and close the file, false if a row couldn't be written
+bool TrialLog_Close(TrialLog *log);
+//Write a binary log as CSV text, false if it isn't a log of this version and layout or ends within a block
+bool TrialLog_ToCSV(const char *path, FILE *csv);
+
+#endif
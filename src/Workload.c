@@ -0,0 +1,240 @@
+#include "Workload.h"
+
+//Encode_Term keeps the name pointers
+static char workload_names[WORKLOAD_ALPHABET_MAX + WORKLOAD_OPERATIONS_MAX + WORKLOAD_OUTCOMES][16];
+static int workload_ids[WORKLOAD_OPERATIONS_MAX];
+//the operation executed within the current step, 0 if none
+static int workload_operation;
+static long workload_decisions;
+
+static void Workload_Executed(void *user, double desire)
+{
+    (void) desire;
+    workload_operation = *(int*) user;
+    workload_decisions++;
+}
+
+static int Workload_CompareLong(const void *a, const void *b)
+{
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+static double Workload_Chance(void)
+{
+    return rand() / ((double) RAND_MAX + 1.0);
+}
+
+bool Workload_Set(Workload_Config *config, const char *assignment)
+{
+    const char *value = strchr(assignment, '=');
+    if(value == NULL || value[1] == 0)
+    {
+        return false;
+    }
+    int length = value - assignment;
+    char *end;
+    double number = strtod(++value, &end);
+    if(*end != 0)
+    {
+        return false;
+    }
+    //each is validated before it's converted
+    static const struct { const char *name; double min; double max; } fields[] = {
+        { "alphabet", 1, WORKLOAD_ALPHABET_MAX }, { "operations", 1, WORKLOAD_OPERATIONS_MAX },
+        { "contingencies", 0, WORKLOAD_CONTINGENCIES_MAX }, { "noise", 0.0, 1.0 }, { "goal_rate", 0.0, 1.0 },
+        { "cycles", 1, INT_MAX }, { "cycles_per_step", 1, 1000 }, { "seed", 0, UINT_MAX } };
+    int field = 0;
+    while(field < 8 && ((int) strlen(fields[field].name) != length || strncmp(assignment, fields[field].name, length)))
+    {
+        field++;
+    }
+    if(field == 8 || !(number >= fields[field].min && number <= fields[field].max))
+    {
+        return false;
+    }
+    switch(field)
+    {
+        case 0: config->alphabet = number; break;
+        case 1: config->operations = number; break;
+        case 2: config->contingencies = number; break;
+        case 3: config->noise = number; break;
+        case 4: config->goalRate = number; break;
+        case 5: config->cycles = number; break;
+        case 6: config->cyclesPerStep = number; break;
+        case 7: config->seed = number; break;
+    }
+    return true;
+}
+
+//the latency of the cycle the input or cycle took
+static void Workload_Time(long *latencies, long *amount, long start)
+{
+    latencies[(*amount)++] = Globals_Nanoseconds() - start;
+}
+
+char *Workload_Name(int index)
+{
+    char *name = workload_names[index];
+    if(index < WORKLOAD_ALPHABET_MAX)
+    {
+        sprintf(name, "w%d", index);
+    }
+    else if(index < WORKLOAD_ALPHABET_MAX + WORKLOAD_OPERATIONS_MAX)
+    {
+        sprintf(name, "^w_op%d", index - WORKLOAD_ALPHABET_MAX);
+    }
+    else
+    {
+        sprintf(name, "w_outcome%d", index - WORKLOAD_ALPHABET_MAX - WORKLOAD_OPERATIONS_MAX);
+    }
+    return name;
+}
+
+//whether the names the configuration uses which aren't encoded yet fit the term dictionary
+static bool Workload_NamesFit(Workload_Config *config)
+{
+    int ranges[3][2] = { { 0, config->alphabet },
+                         { WORKLOAD_ALPHABET_MAX, WORKLOAD_ALPHABET_MAX + config->operations },
+                         { WORKLOAD_ALPHABET_MAX + WORKLOAD_OPERATIONS_MAX, WORKLOAD_ALPHABET_MAX + WORKLOAD_OPERATIONS_MAX + WORKLOAD_OUTCOMES } };
+    int amount = term_index;
+    for(int r=0; r<3; r++)
+    {
+        for(int index=ranges[r][0]; index<ranges[r][1]; index++)
+        {
+            char *name = Workload_Name(index);
+            int i = 0;
+            while(i < term_index && strcmp(terms[i], name))
+            {
+                i++;
+            }
+            amount += i == term_index;
+        }
+    }
+    return amount <= TERMS_ENCODABLE;
+}
+
+bool Workload_Run(Workload_Config *config, Workload_Stats *stats)
+{
+    if(config->alphabet < 1 || config->alphabet > WORKLOAD_ALPHABET_MAX || config->operations < 1 || config->operations > WORKLOAD_OPERATIONS_MAX ||
+       config->contingencies < 0 || config->contingencies > MIN(config->alphabet, WORKLOAD_CONTINGENCIES_MAX) || config->cycles < 1 ||
+       config->cyclesPerStep < 1 || !Workload_NamesFit(config))
+    {
+        return false;
+    }
+    long *latencies = malloc(config->cycles * sizeof(long));
+    if(latencies == NULL)
+    {
+        return false;
+    }
+    srand(config->seed);
+    MSC_INIT();
+    Term stimuli[WORKLOAD_ALPHABET_MAX], outcomes[WORKLOAD_OUTCOMES];
+    for(int i=0; i<config->alphabet; i++)
+    {
+        stimuli[i] = Encode_Term(Workload_Name(i));
+    }
+    for(int i=0; i<WORKLOAD_OUTCOMES; i++)
+    {
+        outcomes[i] = Encode_Term(Workload_Name(WORKLOAD_ALPHABET_MAX + WORKLOAD_OPERATIONS_MAX + i));
+    }
+    for(int i=0; i<config->operations; i++)
+    {
+        workload_ids[i] = i+1;
+        MSC_AddOperationWithContext(Encode_Term(Workload_Name(WORKLOAD_ALPHABET_MAX + i)), Workload_Executed, &workload_ids[i]);
+    }
+    //the contingency of each stimulus which has one: its operation and outcome
+    int operationOf[WORKLOAD_ALPHABET_MAX] = {0}, outcomeOf[WORKLOAD_ALPHABET_MAX];
+    for(int i=0; i<config->contingencies; i++)
+    {
+        int stimulus;
+        do
+        {
+            stimulus = rand() % config->alphabet;
+        }
+        while(operationOf[stimulus] != 0);
+        operationOf[stimulus] = 1 + rand() % config->operations;
+        outcomeOf[stimulus] = i % WORKLOAD_OUTCOMES;
+    }
+    *stats = (Workload_Stats) {0};
+    workload_decisions = 0;
+    long createdBefore = concept_generation;
+    long startTime = currentTime, amount = 0;
+    //headless, the levels being restored after the run
+    int decisionLevel = EVENTLOG_LEVEL[EVENTLOG_DECISION], inputLevel = EVENTLOG_LEVEL[EVENTLOG_INPUT];
+    EVENTLOG_LEVEL[EVENTLOG_DECISION] = EVENTLOG_LEVEL[EVENTLOG_INPUT] = EVENTLOG_OFF;
+    long start = Globals_Nanoseconds();
+    while(amount < config->cycles)
+    {
+        int stimulus = rand() % config->alphabet;
+        workload_operation = 0;
+        //each input takes a cycle
+        long cycleStart = Globals_Nanoseconds();
+        MSC_AddInputBelief(stimuli[Workload_Chance() < config->noise ? rand() % config->alphabet : stimulus], 0);
+        Workload_Time(latencies, &amount, cycleStart);
+        if(amount < config->cycles && Workload_Chance() < config->goalRate)
+        {
+            int outcome = operationOf[stimulus] ? outcomeOf[stimulus] : rand() % WORKLOAD_OUTCOMES;
+            cycleStart = Globals_Nanoseconds();
+            MSC_AddInputGoal(outcomes[outcome]);
+            Workload_Time(latencies, &amount, cycleStart);
+            stats->goals++;
+        }
+        for(int i=0; i<config->cyclesPerStep && amount < config->cycles; i++)
+        {
+            cycleStart = Globals_Nanoseconds();
+            MSC_Cycles(1);
+            Workload_Time(latencies, &amount, cycleStart);
+        }
+        if(workload_operation != 0 && workload_operation == operationOf[stimulus])
+        {
+            stats->successes++;
+            if(amount < config->cycles && Workload_Chance() >= config->noise)
+            {
+                cycleStart = Globals_Nanoseconds();
+                MSC_AddInputBelief(outcomes[outcomeOf[stimulus]], 0);
+                Workload_Time(latencies, &amount, cycleStart);
+            }
+        }
+    }
+    stats->seconds = (Globals_Nanoseconds() - start) / 1e9;
+    EVENTLOG_LEVEL[EVENTLOG_DECISION] = decisionLevel;
+    EVENTLOG_LEVEL[EVENTLOG_INPUT] = inputLevel;
+    stats->cycles = currentTime - startTime;
+    stats->decisions = workload_decisions;
+    stats->concepts = concepts.itemsAmount;
+    stats->conceptsCreated = concept_generation - createdBefore;
+    stats->conceptsEvicted = MAX(0, stats->conceptsCreated - concepts.itemsAmount);
+    long implications = 0;
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi=0; opi<=config->operations; opi++)
+        {
+            implications += c->precondition_beliefs[opi].itemsAmount;
+        }
+    }
+    stats->tableFill = concepts.itemsAmount > 0 ? implications / (double) (concepts.itemsAmount * (config->operations + 1)) : 0.0;
+    qsort(latencies, amount, sizeof(long), Workload_CompareLong);
+    stats->latency50 = latencies[amount / 2];
+    stats->latency90 = latencies[amount * 9 / 10];
+    stats->latency99 = latencies[amount * 99 / 100];
+    stats->latencyMax = latencies[amount - 1];
+    free(latencies);
+    return true;
+}
+
+void Workload_Print(Workload_Config *config, Workload_Stats *stats, FILE *out)
+{
+    fprintf(out, "alphabet=%d operations=%d contingencies=%d noise=%.2f goal_rate=%.2f cycles_per_step=%d seed=%u\n",
+            config->alphabet, config->operations, config->contingencies, config->noise, config->goalRate, config->cyclesPerStep, config->seed);
+    fprintf(out, "cycles=%ld seconds=%.3f cycles/s=%.0f decisions=%ld decisions/s=%.0f successes=%ld goals=%ld\n",
+            stats->cycles, stats->seconds, stats->cycles / stats->seconds, stats->decisions, stats->decisions / stats->seconds,
+            stats->successes, stats->goals);
+    fprintf(out, "concepts=%d created=%ld evicted=%ld churn/cycle=%.3f table fill=%.1f/%d\n",
+            stats->concepts, stats->conceptsCreated, stats->conceptsEvicted, stats->conceptsEvicted / (double) stats->cycles,
+            stats->tableFill, TABLE_SIZE);
+    fprintf(out, "cycle latency us: p50=%.1f p90=%.1f p99=%.1f max=%.1f\n",
+            stats->latency50 / 1e3, stats->latency90 / 1e3, stats->latency99 / 1e3, stats->latencyMax / 1e3);
+}
@@ -0,0 +1,74 @@
+#ifndef H_WORKLOAD
+#define H_WORKLOAD
+
+/////////////////////
+//  MSC Workload   //
+/////////////////////
+//Synthetic environment driving the reasoner headlessly. Each step a random stimulus of the
+//alphabet is sensed, and with the goal rate the outcome of one of the contingencies
+//<(&/,stimulus,^op) =/> outcome> is desired. Executing the operation of the contingency after
+//its stimulus makes the outcome be sensed, except for noise, which also replaces stimuli by
+//random ones. With a large alphabet the sequences of stimuli fill the memory to capacity,
+//so the engine is measured with all concepts in use and full tables.
+
+//References//
+//-----------//
+#include "MSC.h"
+#include "Encode.h"
+
+//Parameters//
+//----------//
+#define WORKLOAD_ALPHABET_MAX 100
+#define WORKLOAD_OPERATIONS_MAX (OPERATIONS_MAX-1)
+#define WORKLOAD_CONTINGENCIES_MAX 64
+#define WORKLOAD_OUTCOMES 4
+
+//Data structure//
+//--------------//
+typedef struct
+{
+    int alphabet;
+    int operations;
+    int contingencies;
+    //chance of a stimulus being replaced and of an outcome not being sensed
+    double noise;
+    //chance of a goal per step
+    double goalRate;
+    long cycles;
+    int cyclesPerStep;
+    unsigned int seed;
+} Workload_Config;
+#define WORKLOAD_DEFAULT ((Workload_Config) { .alphabet = 100, .operations = 4, .contingencies = 16, .noise = 0.1, \
+                                             .goalRate = 0.5, .cycles = 10000, .cyclesPerStep = 3, .seed = 1337 })
+typedef struct
+{
+    long cycles;
+    double seconds;
+    //executed operations, and those which followed the stimulus of a contingency for the desired outcome
+    long decisions;
+    long successes;
+    long goals;
+    int concepts;
+    //concepts which entered memory, and those which evicted another
+    long conceptsCreated;
+    long conceptsEvicted;
+    //mean amount of implications per table, of the registered operations and of no operation
+    double tableFill;
+    //of a single cycle, in nanoseconds
+    long latency50, latency90, latency99, latencyMax;
+} Workload_Stats;
+
+//Methods//
+//-------//
+//The name of the workload term at the index, the stimuli below WORKLOAD_ALPHABET_MAX followed by the operations and
+//the outcomes. The benchmarks fill memory with the stimuli as well, so that all of them together fit the term dictionary.
+char *Workload_Name(int index);
+//Set a field of the configuration from "name=value", false if there is no such field or the value is out of range
+bool Workload_Set(Workload_Config *config, const char *assignment);
+//Run the reasoner from a reset in the environment for the configured cycles, false if the configuration is invalid
+//or its names don't fit the term dictionary
+bool Workload_Run(Workload_Config *config, Workload_Stats *stats);
+//Print the configuration and the stats as a report
+void Workload_Print(Workload_Config *config, Workload_Stats *stats, FILE *out);
+
+#endif
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "Globals.h"
+#include "MSC.h"
+#include "benchmarks.h"
+
+//Runs a ball following task with all event log categories printed to stdout (redirected to /dev/null),
+//put into the ring and drained by the background drainer, or off
+#define BENCH_EVENTLOG_STEPS 300
+#define BENCH_EVENTLOG_RUNS 3
+
+static int bench_eventlog_operation = 0;
+
+static void Bench_OpLeft(void)
+{
+    bench_eventlog_operation = 1;
+}
+
+static void Bench_OpRight(void)
+{
+    bench_eventlog_operation = 2;
+}
+
+//the task with every category at the level, returning the nanoseconds per cycle
+static long Bench_Task(int level)
+{
+    long best = 0;
+    for(int run = 0; run < BENCH_EVENTLOG_RUNS; run++)
+    {
+        srand(1337);
+        MSC_INIT();
+        for(int i = 0; i < EVENTLOG_CATEGORIES; i++)
+        {
+            EVENTLOG_LEVEL[i] = level;
+        }
+        Term left = Encode_Term("bench_ball_left");
+        Term right = Encode_Term("bench_ball_right");
+        Term good = Encode_Term("bench_good");
+        MSC_AddOperation(Encode_Term("bench_op_left"), Bench_OpLeft);
+        MSC_AddOperation(Encode_Term("bench_op_right"), Bench_OpRight);
+        FILE *out = fopen("/dev/null", "wb");
+        if(level == EVENTLOG_RING)
+        {
+            EventLog_RESET();
+            assert(EventLog_StartDrainer(out, false), "EventLog benchmark couldn't start the drainer");
+        }
+        long start = Globals_Nanoseconds();
+        long startTime = currentTime;
+        for(int i = 0; i < BENCH_EVENTLOG_STEPS; i++)
+        {
+            int ball = 1 + rand() % 2;
+            bench_eventlog_operation = 0;
+            MSC_AddInputBelief(ball == 1 ? left : right, 0);
+            MSC_AddInputGoal(good);
+            if(bench_eventlog_operation == ball)
+            {
+                MSC_AddInputBelief(good, 0);
+            }
+            MSC_Cycles(5);
+        }
+        EventLog_StopDrainer();
+        fflush(stdout);
+        long perCycle = (Globals_Nanoseconds() - start) / (currentTime - startTime);
+        best = run == 0 ? perCycle : MIN(best, perCycle);
+        fclose(out);
+    }
+    return best;
+}
+
+void MSC_EventLog_Benchmark(void)
+{
+    fputs(">>MSC EventLog benchmark start\n", stderr);
+    int levels[EVENTLOG_CATEGORIES];
+    for(int i = 0; i < EVENTLOG_CATEGORIES; i++)
+    {
+        levels[i] = EVENTLOG_LEVEL[i];
+    }
+    OUTPUT = 0;
+    //the printed lines go to /dev/null, as in a headless run whose output isn't read
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    dup2(devnull, STDOUT_FILENO);
+    close(devnull);
+    long print = Bench_Task(EVENTLOG_PRINT);
+    long ring = Bench_Task(EVENTLOG_RING);
+    long off = Bench_Task(EVENTLOG_OFF);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    for(int i = 0; i < EVENTLOG_CATEGORIES; i++)
+    {
+        EVENTLOG_LEVEL[i] = levels[i];
+    }
+    fprintf(stderr, "steps=%d ns/cycle: print=%ld ring=%ld off=%ld dropped=%lu\n", BENCH_EVENTLOG_STEPS, print, ring, off, eventlog_dropped);
+    fputs("<<MSC EventLog benchmark end\n", stderr);
+}
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Globals.h"
+#include "Encode.h"
+#include "MSC.h"
+#include "Decision.h"
+#include "benchmarks.h"
+
+//Compares the input latency of immediate, deferred and host execution on a follow task
+#define BENCH_EXECUTION_STEPS 20000
+#define BENCH_EXECUTION_INPUTS_PER_STEP 2
+
+static int bench_last_operation = 0;
+
+static void Bench_OpLeft(void)
+{
+    bench_last_operation = 1;
+}
+
+static void Bench_OpRight(void)
+{
+    bench_last_operation = 2;
+}
+
+static int Bench_CompareLong(const void *a, const void *b)
+{
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+static void Bench_ExecutionMode(int mode, const char *name)
+{
+    static long latencies[BENCH_EXECUTION_STEPS * BENCH_EXECUTION_INPUTS_PER_STEP];
+    int n_latencies = 0;
+    int executions = 0;
+    int goods = 0;
+    srand(1337);
+    OUTPUT = 0;
+    MSC_INIT();
+    MSC_SetInputLogging(false);
+    EXECUTION_MODE = mode;
+    Term ballLeft = Encode_Term("bench_ball_left");
+    Term ballRight = Encode_Term("bench_ball_right");
+    Term good = Encode_Term("bench_good");
+    MSC_AddOperation(Encode_Term("bench_op_left"), Bench_OpLeft);
+    MSC_AddOperation(Encode_Term("bench_op_right"), Bench_OpRight);
+    int ball = 0;
+    long skipped = cycle_work_skipped_total;
+    for(int i = 0; i < BENCH_EXECUTION_STEPS; i++)
+    {
+        bench_last_operation = 0;
+        long start = Globals_Nanoseconds();
+        MSC_AddInputBelief(ball == 1 ? ballLeft : ballRight, 0);
+        long mid = Globals_Nanoseconds();
+        MSC_AddInputGoal(good);
+        if(mode == EXECUTION_HOST)
+        {
+            Decision actions[ACTION_QUEUE_SIZE];
+            int taken = Decision_TakeActions(actions, ACTION_QUEUE_SIZE);
+            for(int j = 0; j < taken; j++)
+            {
+                Decision_Invoke(&actions[j]);
+            }
+        }
+        long end = Globals_Nanoseconds();
+        latencies[n_latencies++] = mid - start;
+        latencies[n_latencies++] = end - mid;
+        if(bench_last_operation != 0)
+        {
+            executions++;
+            if(bench_last_operation == ball)
+            {
+                goods++;
+                MSC_AddInputBelief(good, 0);
+            }
+        }
+        ball = 1 + rand() % 2;
+        MSC_Cycles(5);
+    }
+    qsort(latencies, n_latencies, sizeof(long), Bench_CompareLong);
+    double mean = 0.0;
+    for(int i = 0; i < n_latencies; i++)
+    {
+        mean += latencies[i];
+    }
+    mean /= n_latencies;
+    fprintf(stderr, "%-10s executions=%d goods=%d input latency ns: mean=%.0f p50=%ld p99=%ld max=%ld skipped concepts/cycle=%.1f\n",
+            name, executions, goods, mean,
+            latencies[n_latencies / 2], latencies[(n_latencies * 99) / 100], latencies[n_latencies - 1],
+            (double) (cycle_work_skipped_total - skipped) / currentTime);
+    EXECUTION_MODE = EXECUTION_MODE_INITIAL;
+}
+
+void MSC_Execution_Benchmark(void)
+{
+    fputs(">>MSC Execution benchmark start\n", stderr);
+    Bench_ExecutionMode(EXECUTION_IMMEDIATE, "immediate");
+    Bench_ExecutionMode(EXECUTION_DEFERRED, "deferred");
+    Bench_ExecutionMode(EXECUTION_HOST, "host");
+    fputs("<<MSC Execution benchmark end\n", stderr);
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Globals.h"
+#include "Encode.h"
+#include "MSC.h"
+#include "Workload.h"
+#include "benchmarks.h"
+
+//Measures how long the reasoner is paused by a graph export of a memory filled with sequence concepts
+//and the implications mined between them, against the time the background writer takes
+#define BENCH_GRAPH_TERMS 60
+#define BENCH_GRAPH_INPUTS 4000
+#define BENCH_GRAPH_RUNS 21
+#define BENCH_GRAPH_DOT_PATH "msc_graph_bench.dot"
+#define BENCH_GRAPH_JSON_PATH "msc_graph_bench.jsonl"
+
+static int Bench_CompareLong(const void *a, const void *b)
+{
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+//the export into the path, printing the pause and the time until it was written
+static void Bench_Export(const char *path, int format)
+{
+    long pauses[BENCH_GRAPH_RUNS], writes[BENCH_GRAPH_RUNS];
+    for(int i = 0; i < BENCH_GRAPH_RUNS; i++)
+    {
+        long start = Globals_Nanoseconds();
+        assert(MSC_ExportGraph(path, format), "Graph benchmark couldn't start the export");
+        long mid = Globals_Nanoseconds();
+        assert(Graph_Wait(), "Graph benchmark couldn't write the export");
+        pauses[i] = mid - start;
+        writes[i] = Globals_Nanoseconds() - start;
+    }
+    qsort(pauses, BENCH_GRAPH_RUNS, sizeof(long), Bench_CompareLong);
+    qsort(writes, BENCH_GRAPH_RUNS, sizeof(long), Bench_CompareLong);
+    fprintf(stderr, "%s pause us: p50=%ld max=%ld written us: p50=%ld max=%ld\n", format == GRAPH_JSON ? "json" : "dot",
+            pauses[BENCH_GRAPH_RUNS / 2] / 1000, pauses[BENCH_GRAPH_RUNS - 1] / 1000,
+            writes[BENCH_GRAPH_RUNS / 2] / 1000, writes[BENCH_GRAPH_RUNS - 1] / 1000);
+    remove(path);
+}
+
+void MSC_Graph_Benchmark(void)
+{
+    fputs(">>MSC Graph benchmark start\n", stderr);
+    srand(1337);
+    OUTPUT = 0;
+    MSC_INIT();
+    MSC_SetInputLogging(false);
+    for(int i = 0; i < BENCH_GRAPH_INPUTS; i++)
+    {
+        MSC_AddInputBelief(Encode_Term(Workload_Name(rand() % BENCH_GRAPH_TERMS)), 0);
+    }
+    int implications = 0;
+    for(int i = 0; i < concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi = 0; opi < OPERATIONS_MAX; opi++)
+        {
+            implications += c->precondition_beliefs[opi].itemsAmount;
+        }
+    }
+    fprintf(stderr, "concepts=%d implications=%d\n", concepts.itemsAmount, implications);
+    Bench_Export(BENCH_GRAPH_DOT_PATH, GRAPH_DOT);
+    Bench_Export(BENCH_GRAPH_JSON_PATH, GRAPH_JSON);
+    MSC_SetInputLogging(true);
+    fputs("<<MSC Graph benchmark end\n", stderr);
+}
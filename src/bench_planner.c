@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Globals.h"
+#include "Encode.h"
+#include "MSC.h"
+#include "Decision.h"
+#include "Workload.h"
+#include "benchmarks.h"
+
+//Compares the sweep and the best-first planner on the two-step light switch task of
+//MSC_Multistep2_Test, with memory filled by unrelated sequence concepts the sweep has to visit as well
+#define BENCH_PLANNER_NOISE_TERMS 20
+#define BENCH_PLANNER_NOISE_INPUTS 400
+#define BENCH_PLANNER_GOALS 2000
+
+static int bench_goto_executed = 0;
+static int bench_activate_executed = 0;
+
+static void Bench_GotoSwitch(void)
+{
+    bench_goto_executed++;
+}
+
+static void Bench_ActivateSwitch(void)
+{
+    bench_activate_executed++;
+}
+
+static int Bench_CompareLong(const void *a, const void *b)
+{
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+static void Bench_Planner(bool bestFirst, bool planCache, const char *name)
+{
+    srand(1337);
+    OUTPUT = 0;
+    MSC_INIT();
+    MSC_SetInputLogging(false);
+    MOTOR_BABBLING_CHANCE = 0;
+    BEST_FIRST_PLANNING = bestFirst;
+    PLAN_CACHE = planCache;
+    Term startAt = Encode_Term("bench_start_at");
+    Term switchAt = Encode_Term("bench_switch_at");
+    Term switchActive = Encode_Term("bench_switch_active");
+    Term lightActive = Encode_Term("bench_light_active");
+    Term gotoSwitch = Encode_Term("bench_op_goto_switch");
+    Term activateSwitch = Encode_Term("bench_op_activate_switch");
+    MSC_AddOperation(gotoSwitch, Bench_GotoSwitch);
+    MSC_AddOperation(activateSwitch, Bench_ActivateSwitch);
+    for(int i = 0; i < BENCH_PLANNER_NOISE_INPUTS; i++)
+    {
+        MSC_AddInputBelief(Encode_Term(Workload_Name(rand() % BENCH_PLANNER_NOISE_TERMS)), 0);
+    }
+    for(int i = 0; i < 5; i++)
+    {
+        MSC_AddInputBelief(startAt, 0);
+        MSC_AddInputBelief(gotoSwitch, 1);
+        MSC_Cycles(1);
+        MSC_AddInputBelief(switchAt, 0);
+        MSC_Cycles(10);
+    }
+    MSC_Cycles(1000);
+    for(int i = 0; i < 5; i++)
+    {
+        MSC_AddInputBelief(switchAt, 0);
+        MSC_AddInputBelief(activateSwitch, 2);
+        MSC_AddInputBelief(switchActive, 0);
+        MSC_Cycles(1);
+        MSC_AddInputBelief(lightActive, 0);
+        MSC_Cycles(10);
+    }
+    MSC_Cycles(10);
+    bench_goto_executed = 0;
+    long hits = plan_cache_hits;
+    long misses = plan_cache_misses;
+    static long latencies[BENCH_PLANNER_GOALS];
+    long planning = 0;
+    long work = 0;
+    for(int i = 0; i < BENCH_PLANNER_GOALS; i++)
+    {
+        MSC_AddInputBelief(startAt, 0);
+        long start = Globals_Nanoseconds();
+        MSC_AddInputGoal(lightActive);
+        latencies[i] = Globals_Nanoseconds() - start;
+        planning += latencies[i];
+        work += bestFirst ? planner_expansions_used : (long) propagation_iterations_used * concepts.itemsAmount;
+        MSC_Cycles(10);
+    }
+    qsort(latencies, BENCH_PLANNER_GOALS, sizeof(long), Bench_CompareLong);
+    fprintf(stderr, "%-18s concepts=%d goto executions=%d/%d goal cycle ns: mean=%ld p50=%ld concept visits per goal=%.1f plan cache hits=%ld misses=%ld\n",
+            name, concepts.itemsAmount, bench_goto_executed, BENCH_PLANNER_GOALS,
+            planning / BENCH_PLANNER_GOALS, latencies[BENCH_PLANNER_GOALS / 2], (double) work / BENCH_PLANNER_GOALS, plan_cache_hits - hits, plan_cache_misses - misses);
+    BEST_FIRST_PLANNING = BEST_FIRST_PLANNING_INITIAL;
+    PLAN_CACHE = PLAN_CACHE_INITIAL;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+}
+
+void MSC_Planner_Benchmark(void)
+{
+    fputs(">>MSC Planner benchmark start\n", stderr);
+    Bench_Planner(false, false, "sweep");
+    Bench_Planner(true, false, "best-first");
+    Bench_Planner(true, true, "best-first cached");
+    fputs("<<MSC Planner benchmark end\n", stderr);
+}
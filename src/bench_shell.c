@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Globals.h"
+#include "MSC.h"
+#include "Shell.h"
+#include "benchmarks.h"
+
+//Feeds a recorded protocol file through the shell: the parser alone, and parsing with the reasoner
+#define BENCH_SHELL_EVENTS 5000
+#define BENCH_SHELL_TERMS 16
+#define BENCH_SHELL_RUNS 3
+#define BENCH_SHELL_PATH "msc_shell_bench.txt"
+
+static char bench_shell_recording[BENCH_SHELL_EVENTS * 32];
+
+static int Bench_CompareLong(const void *a, const void *b)
+{
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+//a sensor stream with operation feedback and goals, as an environment simulator would write it
+static size_t Bench_Record(void)
+{
+    size_t length = sprintf(bench_shell_recording, "*op ^left\n*op ^right\n");
+    for(int i = 0; i < BENCH_SHELL_EVENTS; i++)
+    {
+        int r = rand() % 10;
+        char *line = bench_shell_recording + length;
+        if(r == 0)
+        {
+            length += sprintf(line, "%s.\n", rand() % 2 ? "^left" : "^right");
+        }
+        else if(r == 1)
+        {
+            length += sprintf(line, "bench_good! :|:\n");
+        }
+        else
+        {
+            length += sprintf(line, "w%d. :|: %%%.1f;0.9%%\n", rand() % BENCH_SHELL_TERMS, 0.5 + 0.1 * (rand() % 6));
+        }
+    }
+    return length;
+}
+
+void MSC_Shell_Benchmark(void)
+{
+    fputs(">>MSC Shell benchmark start\n", stderr);
+    srand(1337);
+    size_t length = Bench_Record();
+    FILE *file = fopen(BENCH_SHELL_PATH, "wb");
+    fwrite(bench_shell_recording, 1, length, file);
+    fclose(file);
+    //the parser on the lines in memory
+    static char lines[sizeof(bench_shell_recording)];
+    long parses[BENCH_SHELL_RUNS];
+    for(int run = 0; run < BENCH_SHELL_RUNS; run++)
+    {
+        memcpy(lines, bench_shell_recording, length);
+        long start = Globals_Nanoseconds();
+        int parsed = 0;
+        Shell_Command command;
+        for(char *line = lines, *end; (end = memchr(line, '\n', lines + length - line)) != NULL; line = end + 1)
+        {
+            *end = 0;
+            parsed += Shell_Parse(line, &command);
+        }
+        parses[run] = Globals_Nanoseconds() - start;
+        assert(parsed == BENCH_SHELL_EVENTS + 2, "Shell benchmark couldn't parse the recording");
+    }
+    //the recording through a pipe-like file descriptor into the reasoner
+    long runs[BENCH_SHELL_RUNS];
+    FILE *out = fopen("/dev/null", "w");
+    for(int run = 0; run < BENCH_SHELL_RUNS; run++)
+    {
+        MSC_INIT();
+        OUTPUT = 0;
+        MSC_SetInputLogging(false);
+        FILE *in = fopen(BENCH_SHELL_PATH, "rb");
+        long start = Globals_Nanoseconds();
+        assert(Shell_Run(in, out) == 0, "Shell benchmark recording had errors");
+        runs[run] = Globals_Nanoseconds() - start;
+        fclose(in);
+    }
+    fclose(out);
+    remove(BENCH_SHELL_PATH);
+    qsort(parses, BENCH_SHELL_RUNS, sizeof(long), Bench_CompareLong);
+    qsort(runs, BENCH_SHELL_RUNS, sizeof(long), Bench_CompareLong);
+    long parse = parses[BENCH_SHELL_RUNS / 2];
+    long run = runs[BENCH_SHELL_RUNS / 2];
+    fprintf(stderr, "events=%d bytes=%zu parse: ns/line=%ld lines/s=%.0f run: us/event=%.1f events/s=%.0f concepts=%d\n",
+            BENCH_SHELL_EVENTS, length, parse / BENCH_SHELL_EVENTS, BENCH_SHELL_EVENTS * 1e9 / parse,
+            run / 1000.0 / BENCH_SHELL_EVENTS, BENCH_SHELL_EVENTS * 1e9 / run, concepts.itemsAmount);
+    MSC_SetInputLogging(true);
+    fputs("<<MSC Shell benchmark end\n", stderr);
+}
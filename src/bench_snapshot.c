@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Globals.h"
+#include "Encode.h"
+#include "MSC.h"
+#include "Workload.h"
+#include "benchmarks.h"
+
+//Measures saving and loading a memory filled with sequence concepts and the implications mined between them
+#define BENCH_SNAPSHOT_TERMS 60
+#define BENCH_SNAPSHOT_INPUTS 4000
+#define BENCH_SNAPSHOT_RUNS 21
+#define BENCH_SNAPSHOT_PATH "msc_snapshot_bench.bin"
+#define BENCH_JOURNAL_PATH "msc_journal_bench.bin"
+#define BENCH_JOURNAL_INPUTS 100
+
+static long Bench_FileSize(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+static int Bench_CompareLong(const void *a, const void *b)
+{
+    long x = *(const long*) a;
+    long y = *(const long*) b;
+    return (x > y) - (x < y);
+}
+
+void MSC_Snapshot_Benchmark(void)
+{
+    fputs(">>MSC Snapshot benchmark start\n", stderr);
+    srand(1337);
+    OUTPUT = 0;
+    MSC_INIT();
+    MSC_SetInputLogging(false);
+    for(int i = 0; i < BENCH_SNAPSHOT_INPUTS; i++)
+    {
+        MSC_AddInputBelief(Encode_Term(Workload_Name(rand() % BENCH_SNAPSHOT_TERMS)), 0);
+    }
+    int implications = 0;
+    for(int i = 0; i < concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi = 0; opi < OPERATIONS_MAX; opi++)
+        {
+            implications += c->precondition_beliefs[opi].itemsAmount;
+        }
+    }
+    long saves[BENCH_SNAPSHOT_RUNS], loads[BENCH_SNAPSHOT_RUNS];
+    for(int i = 0; i < BENCH_SNAPSHOT_RUNS; i++)
+    {
+        long start = Globals_Nanoseconds();
+        assert(MSC_Save(BENCH_SNAPSHOT_PATH), "Snapshot benchmark couldn't save");
+        long mid = Globals_Nanoseconds();
+        assert(MSC_Load(BENCH_SNAPSHOT_PATH), "Snapshot benchmark couldn't load");
+        long end = Globals_Nanoseconds();
+        saves[i] = mid - start;
+        loads[i] = end - mid;
+    }
+    long size = Bench_FileSize(BENCH_SNAPSHOT_PATH);
+    qsort(saves, BENCH_SNAPSHOT_RUNS, sizeof(long), Bench_CompareLong);
+    qsort(loads, BENCH_SNAPSHOT_RUNS, sizeof(long), Bench_CompareLong);
+    fprintf(stderr, "concepts=%d implications=%d snapshot bytes=%ld save us: p50=%ld max=%ld load us: p50=%ld max=%ld\n",
+            concepts.itemsAmount, implications, size,
+            saves[BENCH_SNAPSHOT_RUNS / 2] / 1000, saves[BENCH_SNAPSHOT_RUNS - 1] / 1000,
+            loads[BENCH_SNAPSHOT_RUNS / 2] / 1000, loads[BENCH_SNAPSHOT_RUNS - 1] / 1000);
+    //the changes of a few more inputs, journaled instead of saved as a whole
+    assert(MSC_OpenJournal(BENCH_SNAPSHOT_PATH, BENCH_JOURNAL_PATH), "Snapshot benchmark couldn't open the journal");
+    for(int i = 0; i < BENCH_JOURNAL_INPUTS; i++)
+    {
+        MSC_AddInputBelief(Encode_Term(Workload_Name(rand() % BENCH_SNAPSHOT_TERMS)), 0);
+    }
+    int records = journal_records;
+    assert(MSC_CloseJournal(), "Snapshot benchmark couldn't write the journal");
+    long recoveries[BENCH_SNAPSHOT_RUNS];
+    for(int i = 0; i < BENCH_SNAPSHOT_RUNS; i++)
+    {
+        long start = Globals_Nanoseconds();
+        assert(MSC_Recover(BENCH_SNAPSHOT_PATH, BENCH_JOURNAL_PATH), "Snapshot benchmark couldn't recover");
+        recoveries[i] = Globals_Nanoseconds() - start;
+    }
+    qsort(recoveries, BENCH_SNAPSHOT_RUNS, sizeof(long), Bench_CompareLong);
+    fprintf(stderr, "inputs=%d journal records=%d bytes=%ld recover us: p50=%ld max=%ld\n",
+            BENCH_JOURNAL_INPUTS, records, Bench_FileSize(BENCH_JOURNAL_PATH),
+            recoveries[BENCH_SNAPSHOT_RUNS / 2] / 1000, recoveries[BENCH_SNAPSHOT_RUNS - 1] / 1000);
+    remove(BENCH_SNAPSHOT_PATH);
+    remove(BENCH_JOURNAL_PATH);
+    fputs("<<MSC Snapshot benchmark end\n", stderr);
+}
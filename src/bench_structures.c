@@ -0,0 +1,355 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include "Globals.h"
+#include "MSC.h"
+#include "benchmarks.h"
+
+//Microbenchmarks of the core data structures and inference kernels. Each kernel runs as many iterations
+//as take BENCH_STRUCTURES_SAMPLE_NS, found by doubling, and the ns/op of BENCH_STRUCTURES_SAMPLES such
+//samples are reported with their standard deviation, so a regression stands out from the noise.
+#define BENCH_STRUCTURES_SAMPLE_NS 2000000
+#define BENCH_STRUCTURES_SAMPLES 15
+//inputs are cycled through, so a kernel doesn't see the same arguments every iteration
+#define BENCH_STRUCTURES_INPUTS 1024
+
+typedef void (*Bench_Kernel)(long iterations);
+//prepares the input of a single iteration, outside of the measured time
+typedef void (*Bench_Setup)(void);
+
+//results are summed into it, so the kernels aren't optimized away
+static volatile double bench_structures_sink;
+static Truth bench_structures_truths[BENCH_STRUCTURES_INPUTS];
+static int bench_structures_indices[BENCH_STRUCTURES_INPUTS];
+static Stamp bench_structures_stamps[2];
+static Event bench_structures_events[2];
+static Implication bench_structures_implications[2];
+static Table bench_structures_table;
+static FIFO bench_structures_fifo;
+static PriorityQueue bench_structures_queue;
+static Item bench_structures_items[CONCEPTS_MAX];
+static Item bench_structures_shuffled[CONCEPTS_MAX];
+static Term bench_structures_terms[CONCEPTS_MAX];
+//grows with every push and event, so each is newer than the ones before
+static double bench_structures_priority = 1.0;
+static long bench_structures_time = 1;
+
+//with a setup, the iterations are timed one by one, each after its setup
+static long Bench_Time(Bench_Kernel kernel, Bench_Setup setup, long iterations)
+{
+    if(setup == NULL)
+    {
+        long start = Globals_Nanoseconds();
+        kernel(iterations);
+        return Globals_Nanoseconds() - start;
+    }
+    long elapsed = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+        setup();
+        long start = Globals_Nanoseconds();
+        kernel(1);
+        elapsed += Globals_Nanoseconds() - start;
+    }
+    return elapsed;
+}
+
+static void Bench_MeasureWithSetup(const char *name, Bench_Kernel kernel, Bench_Setup setup)
+{
+    long iterations = 1;
+    while(Bench_Time(kernel, setup, iterations) < BENCH_STRUCTURES_SAMPLE_NS)
+    {
+        iterations *= 2;
+    }
+    double sum = 0.0, squares = 0.0, min = 0.0;
+    for(int i = 0; i < BENCH_STRUCTURES_SAMPLES; i++)
+    {
+        double ns = Bench_Time(kernel, setup, iterations) / (double) iterations;
+        sum += ns;
+        squares += ns * ns;
+        min = i == 0 ? ns : MIN(min, ns);
+    }
+    double mean = sum / BENCH_STRUCTURES_SAMPLES;
+    double sd = sqrt(MAX(0.0, squares / BENCH_STRUCTURES_SAMPLES - mean * mean));
+    fprintf(stderr, "%-38s ns/op mean=%10.1f sd=%8.2f (%4.1f%%) min=%10.1f iterations=%ld\n",
+            name, mean, sd, 100.0 * sd / mean, min, iterations);
+}
+
+static void Bench_Measure(const char *name, Bench_Kernel kernel)
+{
+    Bench_MeasureWithSetup(name, kernel, NULL);
+}
+
+//the concept of the term of a random index below the fill level is looked up
+static void Bench_FindConcept(long iterations)
+{
+    int found = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+        int index;
+        found += Memory_FindConceptByTerm(&bench_structures_terms[bench_structures_indices[i % BENCH_STRUCTURES_INPUTS]], &index);
+    }
+    bench_structures_sink += found;
+}
+
+//a new term enters the full table at a random rank, evicting the last
+static void Bench_TableAdd(long iterations)
+{
+    for(long i = 0; i < iterations; i++)
+    {
+        Implication imp = { .term = bench_structures_terms[i % CONCEPTS_MAX], .truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS],
+                            .stamp = { .evidentalBase = { i+1 } } };
+        Table_Add(&bench_structures_table, &imp);
+    }
+    bench_structures_sink += bench_structures_table.itemsAmount;
+}
+
+//a term of the full table is revised with new evidence, and re-added at its new rank
+static void Bench_TableAddAndRevise(long iterations)
+{
+    for(long i = 0; i < iterations; i++)
+    {
+        Implication imp = { .term = bench_structures_table.array[bench_structures_indices[i % BENCH_STRUCTURES_INPUTS] % TABLE_SIZE].term,
+                            .truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS], .stamp = { .evidentalBase = { i+1 } } };
+        Table_AddAndRevise(&bench_structures_table, &imp, "");
+    }
+    bench_structures_sink += bench_structures_table.itemsAmount;
+}
+
+static void Bench_StampMake(long iterations)
+{
+    long sum = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_stamps[0].evidentalBase[0] = i+1;
+        sum += Stamp_make(&bench_structures_stamps[0], &bench_structures_stamps[1]).evidentalBase[STAMP_SIZE-1];
+    }
+    bench_structures_sink += sum;
+}
+
+//the full stamps don't overlap, so every pair is compared
+static void Bench_StampCheckOverlap(long iterations)
+{
+    int overlaps = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_stamps[0].evidentalBase[0] = i+1;
+        overlaps += Stamp_checkOverlap(&bench_structures_stamps[0], &bench_structures_stamps[1]);
+    }
+    bench_structures_sink += overlaps;
+}
+
+//the full queue evicts its lowest priority item for a higher one
+static void Bench_PriorityQueuePush(long iterations)
+{
+    int evicted = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_priority += 1e-9;
+        evicted += PriorityQueue_Push(&bench_structures_queue, bench_structures_priority).evicted;
+    }
+    bench_structures_sink += evicted;
+}
+
+//the priorities of all items changed, as the usefulness of the concepts does over time
+static void Bench_PriorityQueueShuffle(void)
+{
+    memcpy(bench_structures_items, bench_structures_shuffled, sizeof(bench_structures_items));
+}
+
+static void Bench_PriorityQueueRebuild(long iterations)
+{
+    for(long i = 0; i < iterations; i++)
+    {
+        PriorityQueue_Rebuild(&bench_structures_queue);
+    }
+    bench_structures_sink += bench_structures_items[0].priority;
+}
+
+//a belief enters the FIFO and forms the sequences with the newest ones
+static void Bench_FIFOAdd(long iterations)
+{
+    for(long i = 0; i < iterations; i++)
+    {
+        long time = bench_structures_time++;
+        Event event = { .term = { .terms = { 1 + i % 32 } }, .type = EVENT_TYPE_BELIEF,
+                        .truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS],
+                        .stamp = { .evidentalBase = { time } }, .occurrenceTime = time };
+        FIFO_Add(&event, &bench_structures_fifo);
+    }
+    bench_structures_sink += bench_structures_fifo.itemsAmount;
+}
+
+static void Bench_TruthExpectation(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        sum += Truth_Expectation(bench_structures_truths[i % BENCH_STRUCTURES_INPUTS]);
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_TruthRevision(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        sum += Truth_Revision(bench_structures_truths[i % BENCH_STRUCTURES_INPUTS], bench_structures_truths[(i+1) % BENCH_STRUCTURES_INPUTS]).confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_TruthDeduction(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        sum += Truth_Deduction(bench_structures_truths[i % BENCH_STRUCTURES_INPUTS], bench_structures_truths[(i+1) % BENCH_STRUCTURES_INPUTS]).confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_TruthInduction(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        sum += Truth_Induction(bench_structures_truths[i % BENCH_STRUCTURES_INPUTS], bench_structures_truths[(i+1) % BENCH_STRUCTURES_INPUTS]).confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_TruthProjection(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        sum += Truth_Projection(bench_structures_truths[i % BENCH_STRUCTURES_INPUTS], 0, 1 + i % 16).confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_InferenceBeliefInduction(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_events[0].truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS];
+        sum += Inference_BeliefInduction(&bench_structures_events[0], &bench_structures_events[1]).truth.confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_InferenceBeliefIntersection(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_events[0].truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS];
+        sum += Inference_BeliefIntersection(&bench_structures_events[0], &bench_structures_events[1]).truth.confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_InferenceImplicationRevision(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_implications[0].truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS];
+        sum += Inference_ImplicationRevision(&bench_structures_implications[0], &bench_structures_implications[1]).truth.confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+static void Bench_InferenceGoalDeduction(long iterations)
+{
+    double sum = 0.0;
+    for(long i = 0; i < iterations; i++)
+    {
+        bench_structures_events[1].truth = bench_structures_truths[i % BENCH_STRUCTURES_INPUTS];
+        sum += Inference_GoalDeduction(&bench_structures_events[1], &bench_structures_implications[0]).truth.confidence;
+    }
+    bench_structures_sink += sum;
+}
+
+void MSC_Structures_Benchmark(void)
+{
+    fputs(">>MSC Structures benchmark start\n", stderr);
+    srand(1337);
+    OUTPUT = 0;
+    for(int i = 0; i < BENCH_STRUCTURES_INPUTS; i++)
+    {
+        bench_structures_truths[i] = (Truth) { .frequency = rand() / (double) RAND_MAX, .confidence = 0.01 + 0.98 * rand() / (double) RAND_MAX };
+    }
+    //terms of sequences, which don't need the term dictionary
+    for(int i = 0; i < CONCEPTS_MAX; i++)
+    {
+        bench_structures_terms[i] = (Term) { .terms = { 1 + i % 32, 1 + i / 32 } };
+    }
+    static const int fills[] = { 16, 256, CONCEPTS_MAX };
+    for(size_t f = 0; f < sizeof(fills) / sizeof(fills[0]); f++)
+    {
+        MSC_INIT();
+        for(int i = 0; i < fills[f]; i++)
+        {
+            Memory_Conceptualize(&bench_structures_terms[i]);
+        }
+        assert(concepts.itemsAmount == fills[f], "Structures benchmark couldn't fill the memory");
+        for(int i = 0; i < BENCH_STRUCTURES_INPUTS; i++)
+        {
+            bench_structures_indices[i] = rand() % fills[f];
+        }
+        char name[64];
+        sprintf(name, "Memory_FindConceptByTerm (%d concepts)", fills[f]);
+        Bench_Measure(name, Bench_FindConcept);
+    }
+    MSC_INIT();
+    for(int i = 0; i < BENCH_STRUCTURES_INPUTS; i++)
+    {
+        bench_structures_indices[i] = rand();
+    }
+    bench_structures_table = (Table) {0};
+    Bench_TableAdd(TABLE_SIZE);
+    Bench_Measure("Table_Add (full)", Bench_TableAdd);
+    Bench_Measure("Table_AddAndRevise (full, revised)", Bench_TableAddAndRevise);
+    for(int i = 0; i < STAMP_SIZE; i++)
+    {
+        bench_structures_stamps[0].evidentalBase[i] = i+1;
+        bench_structures_stamps[1].evidentalBase[i] = STAMP_SIZE+i+1;
+    }
+    Bench_Measure("Stamp_make (full)", Bench_StampMake);
+    Bench_Measure("Stamp_checkOverlap (full, disjoint)", Bench_StampCheckOverlap);
+    PriorityQueue_RESET(&bench_structures_queue, bench_structures_items, CONCEPTS_MAX);
+    for(int i = 0; i < CONCEPTS_MAX; i++)
+    {
+        PriorityQueue_Push(&bench_structures_queue, rand() / (double) RAND_MAX);
+    }
+    Bench_Measure("PriorityQueue_Push (full)", Bench_PriorityQueuePush);
+    for(int i = 0; i < CONCEPTS_MAX; i++)
+    {
+        bench_structures_shuffled[i] = (Item) { .priority = rand() / (double) RAND_MAX };
+    }
+    Bench_MeasureWithSetup("PriorityQueue_Rebuild (1024 changed)", Bench_PriorityQueueRebuild, Bench_PriorityQueueShuffle);
+    bench_structures_fifo = (FIFO) {0};
+    Bench_Measure("FIFO_Add", Bench_FIFOAdd);
+    Bench_Measure("Truth_Expectation", Bench_TruthExpectation);
+    Bench_Measure("Truth_Revision", Bench_TruthRevision);
+    Bench_Measure("Truth_Deduction", Bench_TruthDeduction);
+    Bench_Measure("Truth_Induction", Bench_TruthInduction);
+    Bench_Measure("Truth_Projection", Bench_TruthProjection);
+    bench_structures_events[0] = (Event) { .term = bench_structures_terms[0], .type = EVENT_TYPE_BELIEF, .stamp = bench_structures_stamps[0],
+                                           .occurrenceTime = 1 };
+    bench_structures_events[1] = (Event) { .term = bench_structures_terms[1], .type = EVENT_TYPE_BELIEF, .truth = MSC_DEFAULT_TRUTH,
+                                           .stamp = bench_structures_stamps[1], .occurrenceTime = 3 };
+    bench_structures_implications[0] = (Implication) { .term = bench_structures_terms[0], .stamp = bench_structures_stamps[0], .occurrenceTimeOffset = 2 };
+    bench_structures_implications[1] = (Implication) { .term = bench_structures_terms[0], .truth = MSC_DEFAULT_TRUTH, .stamp = bench_structures_stamps[1],
+                                                       .occurrenceTimeOffset = 3 };
+    Bench_Measure("Inference_BeliefInduction", Bench_InferenceBeliefInduction);
+    Bench_Measure("Inference_BeliefIntersection", Bench_InferenceBeliefIntersection);
+    Bench_Measure("Inference_ImplicationRevision", Bench_InferenceImplicationRevision);
+    Bench_Measure("Inference_GoalDeduction", Bench_InferenceGoalDeduction);
+    fputs("<<MSC Structures benchmark end\n", stderr);
+}
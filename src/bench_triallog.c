@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "Globals.h"
+#include "TrialLog.h"
+#include "benchmarks.h"
+
+//Writes the trial rows of a large replicate sweep as CSV and as columnar log, and converts the log to CSV
+#define BENCH_TRIALLOG_ROWS 500000
+#define BENCH_TRIALLOG_CSV_PATH "msc_triallog_bench.csv"
+#define BENCH_TRIALLOG_PATH "msc_triallog_bench.bin"
+
+static long Bench_FileSize(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+//rows shaped like the Experiment 1 log, returning the time taken
+static long Bench_WriteSweep(TrialLog *log, const char *path, bool binary)
+{
+    static const TrialLog_Column columns[] = {
+        {TRIALLOG_STRING, "phase"}, {TRIALLOG_INT, "block"}, {TRIALLOG_INT, "trial"}, {TRIALLOG_INT, "a1_left"},
+        {TRIALLOG_INT, "chosen_op"}, {TRIALLOG_INT, "correct"}, {TRIALLOG_DOUBLE, "exp_a1_left"}, {TRIALLOG_DOUBLE, "exp_a1_right"},
+        {TRIALLOG_DOUBLE, "exp_a2_left"}, {TRIALLOG_DOUBLE, "exp_a2_right"} };
+    static const char *phases[] = { "baseline", "training", "testing" };
+    srand(1337);
+    long start = Globals_Nanoseconds();
+    assert(TrialLog_Open(log, path, columns, sizeof(columns) / sizeof(columns[0]), binary), "TrialLog benchmark couldn't open the log");
+    for(int i = 0; i < BENCH_TRIALLOG_ROWS; i++)
+    {
+        TrialLog_String(log, phases[(i / 12) % 3]);
+        TrialLog_Int(log, (i / 12) % 9 + 1);
+        TrialLog_Int(log, i % 12 + 1);
+        TrialLog_Int(log, i % 2);
+        TrialLog_Int(log, 1 + rand() % 2);
+        TrialLog_Int(log, rand() % 2);
+        for(int j = 0; j < 4; j++)
+        {
+            TrialLog_Double(log, rand() / (double) RAND_MAX);
+        }
+    }
+    assert(TrialLog_Close(log), "TrialLog benchmark couldn't write the log");
+    return Globals_Nanoseconds() - start;
+}
+
+void MSC_TrialLog_Benchmark(void)
+{
+    static TrialLog log;
+    fputs(">>MSC TrialLog benchmark start\n", stderr);
+    long csv = Bench_WriteSweep(&log, BENCH_TRIALLOG_CSV_PATH, false);
+    long binary = Bench_WriteSweep(&log, BENCH_TRIALLOG_PATH, true);
+    long csvSize = Bench_FileSize(BENCH_TRIALLOG_CSV_PATH);
+    long binarySize = Bench_FileSize(BENCH_TRIALLOG_PATH);
+    FILE *out = fopen("/dev/null", "w");
+    long start = Globals_Nanoseconds();
+    assert(TrialLog_ToCSV(BENCH_TRIALLOG_PATH, out), "TrialLog benchmark couldn't convert the log");
+    long convert = Globals_Nanoseconds() - start;
+    fclose(out);
+    remove(BENCH_TRIALLOG_CSV_PATH);
+    remove(BENCH_TRIALLOG_PATH);
+    fprintf(stderr, "rows=%d csv: ns/row=%ld MB/s=%.0f bytes=%ld columns: ns/row=%ld MB/s=%.0f bytes=%ld to csv: ns/row=%ld\n",
+            BENCH_TRIALLOG_ROWS, csv / BENCH_TRIALLOG_ROWS, csvSize * 1e3 / csv, csvSize,
+            binary / BENCH_TRIALLOG_ROWS, binarySize * 1e3 / binary, binarySize, convert / BENCH_TRIALLOG_ROWS);
+    fputs("<<MSC TrialLog benchmark end\n", stderr);
+}
@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include "Globals.h"
+#include "Workload.h"
+#include "benchmarks.h"
+
+//Runs the synthetic workload with the default configuration, which fills the memory to capacity,
+//and with a small alphabet, whose concepts all stay in memory
+void MSC_Workload_Benchmark(void)
+{
+    fputs(">>MSC Workload benchmark start\n", stderr);
+    OUTPUT = 0;
+    Workload_Stats stats;
+    Workload_Config config = WORKLOAD_DEFAULT;
+    assert(Workload_Run(&config, &stats), "Workload benchmark couldn't run the default configuration");
+    Workload_Print(&config, &stats, stderr);
+    config.alphabet = 8;
+    config.contingencies = 4;
+    assert(Workload_Run(&config, &stats), "Workload benchmark couldn't run the small configuration");
+    Workload_Print(&config, &stats, stderr);
+    fputs("<<MSC Workload benchmark end\n", stderr);
+}
@@ -0,0 +1,14 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+void MSC_Execution_Benchmark(void);
+void MSC_Planner_Benchmark(void);
+void MSC_Snapshot_Benchmark(void);
+void MSC_Shell_Benchmark(void);
+void MSC_TrialLog_Benchmark(void);
+void MSC_EventLog_Benchmark(void);
+void MSC_Graph_Benchmark(void);
+void MSC_Structures_Benchmark(void);
+void MSC_Workload_Benchmark(void);
+
+#endif
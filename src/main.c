@@ -4,6 +4,10 @@
 #include "MSC.h"
 #include "tests.h"
 #include "demos.h"
+#include "benchmarks.h"
+#include "Shell.h"
+#include "TrialLog.h"
+#include "Workload.h"
 
 typedef void (*TestFunction)(void);
 
@@ -20,12 +24,33 @@ static const RegressionTest kRegressionTests[] = {
     {"table", Table_Test},
     {"alphabet", MSC_Alphabet_Test},
     {"procedure", MSC_Procedure_Test},
+    {"deferred_execution", MSC_DeferredExecution_Test},
+    {"operation_context", MSC_OperationContext_Test},
+    {"propagation_budget", MSC_PropagationBudget_Test},
     {"memory", Memory_Test},
+    {"input_ring", InputRing_Test},
+    {"anticipation", Anticipation_Test},
     {"follow", MSC_Follow_Test},
     {"multistep", MSC_Multistep_Test},
     {"multistep2", MSC_Multistep2_Test},
+    {"best_first_planning", MSC_BestFirstPlanning_Test},
+    {"plan_cache", MSC_PlanCache_Test},
     {"sequence", Sequence_Test},
     {"sequence_len3", MSC_SequenceLen3_Test},
+    {"mining_horizon", MSC_MiningHorizon_Test},
+    {"advance_time", MSC_AdvanceTime_Test},
+    {"dirty_tracking", MSC_DirtyTracking_Test},
+    {"snapshot", MSC_Snapshot_Test},
+    {"concept_store", Memory_ConceptStore_Test},
+    {"journal", MSC_Journal_Test},
+    {"shell", MSC_Shell_Test},
+    {"trace", MSC_Trace_Test},
+    {"trial_log", TrialLog_Test},
+    {"event_log", MSC_EventLog_Test},
+    {"graph", MSC_Graph_Test},
+    {"workload", MSC_Workload_Test},
+    {"stats", MSC_Stats_Test},
+    {"perf", MSC_Perf_Test},
     {"exp1", MSC_Exp1_Test},
     {"exp1_training", MSC_Exp1_TrainingOnly},
     {"exp3", MSC_Exp3_Test},
@@ -33,6 +58,20 @@ static const RegressionTest kRegressionTests[] = {
 
 static const size_t kRegressionTestCount = sizeof(kRegressionTests) / sizeof(kRegressionTests[0]);
 
+static const RegressionTest kBenchmarks[] = {
+    {"execution", MSC_Execution_Benchmark},
+    {"planner", MSC_Planner_Benchmark},
+    {"snapshot", MSC_Snapshot_Benchmark},
+    {"shell", MSC_Shell_Benchmark},
+    {"trial_log", MSC_TrialLog_Benchmark},
+    {"event_log", MSC_EventLog_Benchmark},
+    {"graph", MSC_Graph_Benchmark},
+    {"structures", MSC_Structures_Benchmark},
+    {"workload", MSC_Workload_Benchmark},
+};
+
+static const size_t kBenchmarkCount = sizeof(kBenchmarks) / sizeof(kBenchmarks[0]);
+
 static const RegressionTest *FindRegressionTest(const char *name)
 {
     for(size_t i = 0; i < kRegressionTestCount; i++)
@@ -62,19 +101,153 @@ static void PrintTestList(void)
     }
 }
 
+static void RunBenchmarks(const char *name)
+{
+    //the hardware counts of each benchmark, where the counters are available
+    if(!Perf_Open())
+    {
+        fprintf(stderr, "perf: hardware counters unavailable (%s), wall-clock times only\n", Perf_Error());
+    }
+    for(size_t i = 0; i < kBenchmarkCount; i++)
+    {
+        if(name == NULL || strcmp(name, kBenchmarks[i].name) == 0)
+        {
+            Perf_Counts start, counts;
+            Perf_Read(&start);
+            kBenchmarks[i].function();
+            Perf_Since(&start, &counts);
+            if(Perf_Counting(PERF_CYCLES) || Perf_Counting(PERF_INSTRUCTIONS))
+            {
+                fprintf(stderr, "perf %s: ", kBenchmarks[i].name);
+                Perf_Print(&counts, stderr);
+            }
+        }
+    }
+    Perf_Close();
+}
+
+static void PrintBenchmarkList(void)
+{
+    puts("Available benchmarks:");
+    for(size_t i = 0; i < kBenchmarkCount; i++)
+    {
+        printf("  %s\n", kBenchmarks[i].name);
+    }
+}
+
 static void PrintUsage(const char *program)
 {
-    printf("Usage: %s [--run-all-tests | --test <name> | --list-tests | --exp1-csv <path> | --exp2-csv <path> | --exp3-csv <path> | pong | pongX | pong2 | pong2X | testchamber | alien | simple_discriminations]\n", program);
+    printf("Usage: %s [--run-all-tests | --test <name> | --list-tests | --bench [name] | --exp1-csv <path> | --exp2-csv <path> | --exp3-csv <path> | --exp<1|2|3>-log <path> | --log-to-csv <log> [csv] | --replay <trace> | --workload [name=value...] | [--record <trace>] [--graph <path> <cycles>] [--profile <cycles>] shell | pong | pongX | pong2 | pong2X | testchamber | alien | simple_discriminations]\n", program);
+}
+
+static void StopTrace(void)
+{
+    if(!Trace_Stop())
+    {
+        fputs("Error: the trace couldn't be written.\n", stderr);
+    }
+}
+
+static const char *graphPath;
+
+//the graph at the end of the run, once the last periodic export is written
+static void StopGraph(void)
+{
+    Graph_Wait();
+    if(!MSC_ExportGraph(graphPath, Graph_Format(graphPath)) || !Graph_Wait())
+    {
+        fprintf(stderr, "Error: the graph '%s' couldn't be written.\n", graphPath);
+    }
+}
+
+//the stats of the whole run
+static void StopProfile(void)
+{
+    Profile_Stats stats;
+    MSC_GetStats(&stats);
+    fputs("stats: ", stderr);
+    Profile_Print(&stats, stderr);
+}
+
+static int ReplayTrace(const char *path)
+{
+    long start = Globals_Nanoseconds();
+    bool identical = MSC_Replay(path);
+    double seconds = (Globals_Nanoseconds() - start) / 1e9;
+    if(!identical && !trace_diverged)
+    {
+        fprintf(stderr, "Error: '%s' is no trace of this build.\n", path);
+        return 1;
+    }
+    if(!identical)
+    {
+        printf("Diverged at record %ld (time %ld).\n", trace_position, currentTime);
+        return 1;
+    }
+    printf("Replayed %ld records to time %ld in %.3f s (%.0f cycles/s), identical.\n",
+           trace_position, currentTime, seconds, currentTime / seconds);
+    return 0;
 }
 
 int main(int argc, char *argv[])
 {
+    //record what the mode drives the reasoner with, for --replay
+    if(argc > 3 && !strcmp(argv[1], "--record"))
+    {
+        if(!Trace_Start(argv[2]))
+        {
+            fprintf(stderr, "Error: can't write the trace '%s'.\n", argv[2]);
+            return 1;
+        }
+        atexit(StopTrace);
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+    //export the implication graph periodically while the mode runs
+    if(argc > 4 && !strcmp(argv[1], "--graph"))
+    {
+        long cycles = atol(argv[3]);
+        if(cycles <= 0)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        graphPath = argv[2];
+        MSC_ExportGraphEvery(graphPath, Graph_Format(graphPath), cycles);
+        atexit(StopGraph);
+        argv[3] = argv[0];
+        argv += 3;
+        argc -= 3;
+    }
+    //profile the phases of the cycles while the mode runs, reporting the stats periodically and at the end
+    if(argc > 3 && !strcmp(argv[1], "--profile"))
+    {
+        char *end;
+        long cycles = strtol(argv[2], &end, 10);
+        if(*end != 0 || cycles < 0)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        PROFILING = true;
+        if(!Perf_Open())
+        {
+            fprintf(stderr, "perf: hardware counters unavailable (%s), timing the phases only\n", Perf_Error());
+        }
+        MSC_ReportStatsEvery(cycles);
+        atexit(StopProfile);
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
     if(argc > 1)
     {
         if(!strcmp(argv[1], "--help") || !strcmp(argv[1], "-h"))
         {
             PrintUsage(argv[0]);
             PrintTestList();
+            PrintBenchmarkList();
             return 0;
         }
         if(!strcmp(argv[1], "--list-tests"))
@@ -82,6 +255,11 @@ int main(int argc, char *argv[])
             PrintTestList();
             return 0;
         }
+        if(!strcmp(argv[1], "--bench"))
+        {
+            RunBenchmarks(argc >= 3 ? argv[2] : NULL);
+            return 0;
+        }
         if(!strcmp(argv[1], "--exp1-csv"))
         {
             const char *path = (argc >= 3) ? argv[2] : "exp1.csv";
@@ -100,6 +278,78 @@ int main(int argc, char *argv[])
             MSC_Exp3_ExportCSV(path);
             return 0;
         }
+        if(!strcmp(argv[1], "--exp1-log"))
+        {
+            const char *path = (argc >= 3) ? argv[2] : "exp1.log";
+            MSC_Exp1_ExportLog(path);
+            return 0;
+        }
+        if(!strcmp(argv[1], "--exp2-log"))
+        {
+            const char *path = (argc >= 3) ? argv[2] : "exp2.log";
+            MSC_Exp2_ExportLog(path);
+            return 0;
+        }
+        if(!strcmp(argv[1], "--exp3-log"))
+        {
+            const char *path = (argc >= 3) ? argv[2] : "exp3.log";
+            MSC_Exp3_ExportLog(path);
+            return 0;
+        }
+        if(!strcmp(argv[1], "--log-to-csv"))
+        {
+            if(argc < 3)
+            {
+                fputs("Error: missing log path.\n", stderr);
+                PrintUsage(argv[0]);
+                return 1;
+            }
+            FILE *csv = argc >= 4 ? fopen(argv[3], "w") : stdout;
+            bool converted = csv != NULL && TrialLog_ToCSV(argv[2], csv);
+            if(csv != NULL && csv != stdout)
+            {
+                converted = fclose(csv) == 0 && converted;
+            }
+            if(!converted)
+            {
+                fprintf(stderr, "Error: couldn't convert the trial log '%s'.\n", argv[2]);
+                return 1;
+            }
+            return 0;
+        }
+        if(!strcmp(argv[1], "--replay"))
+        {
+            if(argc < 3)
+            {
+                fputs("Error: missing trace path.\n", stderr);
+                PrintUsage(argv[0]);
+                return 1;
+            }
+            OUTPUT = 0;
+            MSC_SetInputLogging(false);
+            return ReplayTrace(argv[2]);
+        }
+        if(!strcmp(argv[1], "--workload"))
+        {
+            Workload_Config config = WORKLOAD_DEFAULT;
+            for(int i = 2; i < argc; i++)
+            {
+                if(!Workload_Set(&config, argv[i]))
+                {
+                    fprintf(stderr, "Error: invalid workload setting '%s'.\n", argv[i]);
+                    return 1;
+                }
+            }
+            Workload_Stats stats;
+            OUTPUT = 0;
+            if(!Workload_Run(&config, &stats))
+            {
+                fputs("Error: the workload needs at least as many stimuli as contingencies, and names which fit the term dictionary.\n", stderr);
+                return 1;
+            }
+            Workload_Print(&config, &stats, stdout);
+            return 0;
+        }
         if(!strcmp(argv[1], "--run-all-tests"))
         {
             srand(1337);
@@ -131,6 +381,13 @@ int main(int argc, char *argv[])
             test->function();
             return 0;
         }
+        if(!strcmp(argv[1], "shell"))
+        {
+            MSC_INIT();
+            OUTPUT = 0;
+            MSC_SetInputLogging(false);
+            return Shell_Run(stdin, stdout) > 0;
+        }
         if(!strcmp(argv[1], "pong"))
         {
             MSC_Pong();
@@ -6,8 +6,29 @@ void FIFO_Test(void);
 void PriorityQueue_Test(void);
 void Table_Test(void);
 void Memory_Test(void);
+void InputRing_Test(void);
+void Anticipation_Test(void);
 void MSC_Alphabet_Test(void);
 void MSC_Procedure_Test(void);
+void MSC_DeferredExecution_Test(void);
+void MSC_OperationContext_Test(void);
+void MSC_PropagationBudget_Test(void);
+void MSC_BestFirstPlanning_Test(void);
+void MSC_PlanCache_Test(void);
+void MSC_MiningHorizon_Test(void);
+void MSC_AdvanceTime_Test(void);
+void MSC_DirtyTracking_Test(void);
+void MSC_Snapshot_Test(void);
+void Memory_ConceptStore_Test(void);
+void MSC_Journal_Test(void);
+void MSC_Shell_Test(void);
+void MSC_Trace_Test(void);
+void TrialLog_Test(void);
+void MSC_EventLog_Test(void);
+void MSC_Graph_Test(void);
+void MSC_Workload_Test(void);
+void MSC_Stats_Test(void);
+void MSC_Perf_Test(void);
 void MSC_Follow_Test(void);
 void MSC_Multistep_Test(void);
 void MSC_Multistep2_Test(void);
@@ -16,8 +37,11 @@ void MSC_SequenceLen3_Test(void);
 void MSC_Exp1_Test(void);
 void MSC_Exp1_TrainingOnly(void);
 void MSC_Exp1_ExportCSV(const char *path);
+void MSC_Exp1_ExportLog(const char *path);
 void MSC_Exp2_ExportCSV(const char *path);
+void MSC_Exp2_ExportLog(const char *path);
 void MSC_Exp3_Test(void);
 void MSC_Exp3_ExportCSV(const char *path);
+void MSC_Exp3_ExportLog(const char *path);
 
 #endif
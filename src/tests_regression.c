@@ -2,17 +2,23 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
+#include <sys/stat.h>
 #include "Term.h"
 #include "Memory.h"
 #include "Concept.h"
 #include "Encode.h"
 #include "MSC.h"
 #include "PriorityQueue.h"
+#include "TrialLog.h"
+#include "Workload.h"
 #include "Table.h"
 #include "Implication.h"
 #include "Decision.h"
 #include "Globals.h"
 #include "Truth.h"
+#include "InputRing.h"
+#include "Shell.h"
 #include "tests.h"
 
 #define EXP1_OP_LEFT_ID 1
@@ -70,6 +76,11 @@ void FIFO_Test(void)
     {
         assert(FIFO_SIZE - i == fifo.array[0][i].stamp.evidentalBase[0], "Item at FIFO position has to be right");
     }
+    //the k-th newest event occurred at 30-10k
+    assert(FIFO_AmountSince(&fifo, 31) == 0, "No event occurred after 30");
+    assert(FIFO_AmountSince(&fifo, 30) == 1, "Only the newest event occurred at 30");
+    assert(FIFO_AmountSince(&fifo, 0) == 4, "Four events occurred since 0");
+    assert(FIFO_AmountSince(&fifo, -1000) == FIFO_SIZE, "All events occurred since -1000");
     int newbase = FIFO_SIZE * 2 + 1;
     Event event2 = {
         .term = Encode_Term("test"),
@@ -92,6 +103,7 @@ void FIFO_Test(void)
         }
     }
     assert(fifo2.itemsAmount == FIFO_SIZE, "FIFO size differs");
+    assert(FIFO_GetNewestAnnotation(&fifo2, 0)->stampSignature == Stamp_signature(&event2.stamp), "Annotation has to match its entry");
     puts("<<FIFO Test successful");
 }
 
@@ -106,6 +118,9 @@ void Stamp_Test(void)
     fputs("zipped:", stdout);
     Stamp_print(&stamp3);
     assert(Stamp_checkOverlap(&stamp1, &stamp2) == true, "Stamp should overlap");
+    Stamp stamp4 = { .evidentalBase = {5,6} };
+    assert((Stamp_signature(&stamp1) & Stamp_signature(&stamp2)) != 0, "Signatures of overlapping stamps have to intersect");
+    assert((Stamp_signature(&stamp1) & Stamp_signature(&stamp4)) == 0, "Signatures of these stamps should be disjoint");
     puts("<<Stamp test successful");
 }
 
@@ -136,6 +151,21 @@ void PriorityQueue_Test(void)
             evictions++;
         }
     }
+    for(int i = 0; i < n_items; i++)
+    {
+        double maxPriority = 0.0;
+        for(int j = 0; j < queue.itemsAmount; j++)
+        {
+            maxPriority = queue.items[j].priority > maxPriority ? queue.items[j].priority : maxPriority;
+        }
+        void *address;
+        assert(PriorityQueue_PopMax(&queue, &address), "the queue should not be empty yet");
+        for(int j = 0; j < queue.itemsAmount; j++)
+        {
+            assert(queue.items[j].priority < maxPriority, "the highest priority item has to be popped first");
+        }
+    }
+    assert(queue.itemsAmount == 0, "all items should have been popped");
     puts("<<PriorityQueue test successful");
 }
 
@@ -204,9 +234,196 @@ void Memory_Test(void)
     assert(c2 == concepts.items[returnIndex].address, "e2 should closest-match to c2!");
     assert(Memory_FindConceptByTerm(&e.term, &returnIndex), "Concept should be found!");
     assert(c == concepts.items[returnIndex].address, "e should closest-match to c!");
+    Event e3 = Event_InputEvent(Encode_Term("c"), EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 1337);
+    assert(Memory_ResolveConcept(&e3) == NULL && e3.conceptGeneration < 0, "The miss should be cached in the event");
+    Memory_ConceptualizeEvent(&e3);
+    assert(Memory_ResolveConcept(&e3) != NULL && e3.conceptGeneration > 0, "The new concept should be cached in the event");
+    assert(Memory_ResolveConcept(&e) == c, "The handle should resolve to c");
     puts("<<Memory test successful");
 }
 
+#define INPUT_RING_TEST_ENTRIES 200000
+static InputRing input_ring_test;
+static Term input_ring_terms[8];
+
+//each entry's fields follow from its index, so a consumer can tell a torn or reordered one
+static void *InputRing_TestProducer(void *unused)
+{
+    (void) unused;
+    for(long i=0; i<INPUT_RING_TEST_ENTRIES; i++)
+    {
+        InputRing_Entry *entry;
+        while((entry = InputRing_Reserve(&input_ring_test)) == NULL);
+        entry->term = input_ring_terms[i % 8];
+        entry->type = i % 2 ? EVENT_TYPE_BELIEF : EVENT_TYPE_GOAL;
+        entry->truth = (Truth) { .frequency = (i % 100) / 100.0, .confidence = 0.5 };
+        entry->operationID = i % 7;
+        entry->timestamp = i;
+        InputRing_Commit(&input_ring_test);
+    }
+    return NULL;
+}
+
+//a sensor only pushes terms encoded before it started
+static void *InputRing_TestSensor(void *unused)
+{
+    (void) unused;
+    for(long i=0; i<2000; i++)
+    {
+        while(!MSC_PushInput(input_ring_terms[i % 8], EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 0, 0));
+    }
+    return NULL;
+}
+
+void InputRing_Test(void)
+{
+    puts(">>InputRing test start");
+    static InputRing ring;
+    InputRing_RESET(&ring);
+    Term a = Encode_Term("a");
+    for(int round = 0; round < 3; round++)
+    {
+        for(int i = 0; i < INPUT_RING_SIZE; i++)
+        {
+            assert(InputRing_Push(&ring, a, EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 0, i), "Ring should accept entries until full");
+        }
+        assert(!InputRing_Push(&ring, a, EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 0, 0), "Ring should reject entries when full");
+        assert(InputRing_Size(&ring) == INPUT_RING_SIZE, "Ring size differs");
+        for(int i = 0; i < INPUT_RING_SIZE; i++)
+        {
+            InputRing_Entry *entry = InputRing_Front(&ring);
+            assert(entry != NULL && entry->timestamp == i, "Entries have to come out in insertion order");
+            InputRing_Release(&ring);
+        }
+        assert(InputRing_Front(&ring) == NULL, "Ring should be empty");
+    }
+    //a producer thread against the consumer, which only sees entries the producer completed
+    for(int i=0; i<8; i++)
+    {
+        char name[16];
+        sprintf(name, "ring%d", i);
+        input_ring_terms[i] = Encode_Term(name);
+    }
+    InputRing_RESET(&input_ring_test);
+    pthread_t producer;
+    assert(pthread_create(&producer, NULL, InputRing_TestProducer, NULL) == 0, "The producer should have been started");
+    for(long i=0; i<INPUT_RING_TEST_ENTRIES; i++)
+    {
+        InputRing_Entry *entry;
+        while((entry = InputRing_Front(&input_ring_test)) == NULL);
+        assert(entry->timestamp == i && Term_Equal(&entry->term, &input_ring_terms[i % 8]) && entry->operationID == i % 7 &&
+               entry->type == (i % 2 ? EVENT_TYPE_BELIEF : EVENT_TYPE_GOAL) && entry->truth.frequency == (i % 100) / 100.0,
+               "Entries of the producer thread have to arrive complete and in order");
+        InputRing_Release(&input_ring_test);
+    }
+    pthread_join(producer, NULL);
+    assert(InputRing_Size(&input_ring_test) == 0, "All entries should have been consumed");
+    //a sensor thread queueing inputs while the reasoner runs
+    MSC_INIT();
+    pthread_t sensor;
+    assert(pthread_create(&sensor, NULL, InputRing_TestSensor, NULL) == 0, "The sensor should have been started");
+    //quietly, the inputs being many
+    int inputLevel = EVENTLOG_LEVEL[EVENTLOG_INPUT], output = OUTPUT;
+    EVENTLOG_LEVEL[EVENTLOG_INPUT] = EVENTLOG_OFF;
+    OUTPUT = 0;
+    long startTime = currentTime;
+    int drained = 0;
+    while(drained < 2000)
+    {
+        drained += MSC_DrainInputs();
+    }
+    pthread_join(sensor, NULL);
+    EVENTLOG_LEVEL[EVENTLOG_INPUT] = inputLevel;
+    OUTPUT = output;
+    assert(drained == 2000 && currentTime - startTime == 2000, "Each input of the sensor thread should have taken a cycle");
+    for(int i=0; i<8; i++)
+    {
+        assert(Memory_FindConceptByTerm(&input_ring_terms[i], NULL), "The inputs of the sensor thread should have formed concepts");
+    }
+    MSC_INIT();
+    Term b = Encode_Term("b");
+    assert(MSC_PushInput(a, EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 0, 0), "Input should have been queued");
+    assert(MSC_PushInput(b, EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 0, currentTime + 10), "Input should have been queued");
+    MSC_Cycles(1);
+    assert(Memory_FindConceptByTerm(&a, NULL), "Queued input should have been drained at the cycle boundary");
+    assert(!Memory_FindConceptByTerm(&b, NULL), "Input is not due yet");
+    MSC_Cycles(10);
+    assert(Memory_FindConceptByTerm(&b, NULL), "Input should have been drained once due");
+    puts("<<InputRing test successful");
+}
+
+static Concept *Test_ConceptOf(Term term)
+{
+    int index;
+    assert(Memory_FindConceptByTerm(&term, &index), "Concept should exist");
+    return concepts.items[index].address;
+}
+
+void Anticipation_Test(void)
+{
+    puts(">>Anticipation test start");
+    static AnticipationWheel wheel;
+    MSC_INIT();
+    Term a = Encode_Term("a");
+    Term b = Encode_Term("b");
+    Term c = Encode_Term("c");
+    MSC_AddInputBelief(a, 0);
+    MSC_AddInputBelief(b, 0);
+    MSC_AddInputBelief(c, 0);
+    Concept *A = Test_ConceptOf(a);
+    Concept *B = Test_ConceptOf(b);
+    Concept *C = Test_ConceptOf(c);
+    Truth negative = { .frequency = 0.0, .confidence = 0.1 };
+    Anticipation_RESET(&wheel, 0);
+    assert(Anticipation_Schedule(&wheel, A, 0, c, negative, 5), "Wheel should have space");
+    assert(Anticipation_Schedule(&wheel, A, 0, c, negative, 7), "Equal anticipation should be accepted");
+    assert(wheel.amount == 1, "Equal anticipation should not have been added again");
+    assert(Anticipation_Schedule(&wheel, B, 0, c, negative, 3), "Wheel should have space");
+    assert(Anticipation_Schedule(&wheel, B, 1, c, negative, 4), "Wheel should have space");
+    assert(Anticipation_Schedule(&wheel, C, 0, a, negative, 200), "Wheel should have space");
+    assert(Anticipation_Schedule(&wheel, C, 0, b, negative, 5000), "Wheel should have space");
+    assert(Anticipation_Confirm(&wheel, B) == 2, "Both anticipations of B should have been confirmed");
+    assert(Anticipation_Confirm(&wheel, B) == 0, "B has no anticipations left");
+    Anticipation expired;
+    assert(!Anticipation_PopExpired(&wheel, 5, &expired), "Nothing is due before 5");
+    assert(Anticipation_PopExpired(&wheel, 6, &expired) && expired.postcondition == A && expired.due == 5, "A should have expired");
+    assert(!Anticipation_PopExpired(&wheel, 200, &expired), "Nothing is due before 200");
+    assert(Anticipation_PopExpired(&wheel, 201, &expired) && expired.postcondition == C && expired.due == 200, "C should have expired from level 1");
+    assert(!Anticipation_PopExpired(&wheel, 5000, &expired), "Nothing is due before 5000");
+    assert(Anticipation_PopExpired(&wheel, 6000, &expired) && expired.due == 5000, "C should have expired from the overflow");
+    assert(wheel.amount == 0, "Wheel should be empty");
+    for(int i = 0; i < ANTICIPATIONS_MAX; i++)
+    {
+        Term precondition = {0};
+        precondition.terms[0] = 1 + i % 100;
+        precondition.terms[1] = 1 + i / 100;
+        assert(Anticipation_Schedule(&wheel, A, 0, precondition, negative, 6000 + i), "Wheel should have space");
+    }
+    assert(!Anticipation_Schedule(&wheel, B, 0, a, negative, 6000), "Wheel should be full");
+    assert(Anticipation_Confirm(&wheel, A) == ANTICIPATIONS_MAX, "All anticipations of A should have been confirmed");
+    //scheduled negative evidence is only added once the anticipated event is overdue
+    MSC_INIT();
+    MOTOR_BABBLING_CHANCE = 0;
+    ANTICIPATION_SCHEDULED = true;
+    for(int i = 0; i < 5; i++)
+    {
+        MSC_AddInputBelief(a, 0);
+        MSC_Cycles(2);
+        MSC_AddInputBelief(b, 0);
+        MSC_Cycles(50);
+    }
+    B = Test_ConceptOf(b);
+    double expectation = Exp_BestExpectationFor(B, 0, &a);
+    assert(expectation > 0.5, "<a =/> b> should have been learned");
+    MSC_AddInputBelief(a, 0);
+    assert(Exp_BestExpectationFor(B, 0, &a) == expectation, "b isn't overdue yet");
+    MSC_Cycles(50);
+    assert(Exp_BestExpectationFor(B, 0, &a) < expectation, "Missing b should have weakened <a =/> b>");
+    ANTICIPATION_SCHEDULED = ANTICIPATION_SCHEDULED_INITIAL;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    puts("<<Anticipation test successful");
+}
+
 void MSC_Alphabet_Test(void)
 {
     MSC_INIT();
@@ -257,6 +474,115 @@ void MSC_Procedure_Test(void)
     puts("<<MSC Procedure test successful");
 }
 
+void MSC_DeferredExecution_Test(void)
+{
+    MSC_INIT();
+    MOTOR_BABBLING_CHANCE = 0;
+    puts(">>MSC Deferred execution test start");
+    MSC_AddOperation(Encode_Term("op"), MSC_Procedure_Test_Op);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputBelief(Encode_Term("op"), 1);
+    MSC_AddInputBelief(Encode_Term("result"), 0);
+    MSC_Cycles(10);
+    EXECUTION_MODE = EXECUTION_DEFERRED;
+    MSC_Procedure_Test_Op_executed = false;
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("result"));
+    assert(MSC_Procedure_Test_Op_executed, "Deferred op should have been dispatched after the cycle");
+    assert(FIFO_GetNewestSequence(&belief_events, 0)->operationID == 0, "Operator feedback should wait for the next cycle boundary");
+    MSC_Cycles(1);
+    assert(FIFO_GetNewestSequence(&belief_events, 0)->operationID == 1, "Operator feedback should have been injected");
+    MSC_Cycles(10);
+    EXECUTION_MODE = EXECUTION_HOST;
+    MSC_Procedure_Test_Op_executed = false;
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("result"));
+    Decision actions[ACTION_QUEUE_SIZE];
+    int taken = Decision_TakeActions(actions, ACTION_QUEUE_SIZE);
+    assert(!MSC_Procedure_Test_Op_executed, "Host mode must not invoke the callback");
+    assert(taken == 1 && actions[0].operationID == 1, "The op should have been handed to the host");
+    //a host which doesn't take its actions loses the oldest ones, counted as dropped
+    while(Decision_TakeFeedback(&actions[0]));
+    long actionsDropped = decision_actions_dropped, feedbackDropped = decision_feedback_dropped;
+    for(int i = 0; i < ACTION_QUEUE_SIZE + 4; i++)
+    {
+        Decision decision = { .execute = true, .operationID = 1, .desire = i };
+        Decision_Execute(&decision);
+    }
+    assert(decision_actions_dropped - actionsDropped == 4 && decision_feedback_dropped - feedbackDropped == 4,
+           "The decisions beyond full queues should have been counted as dropped");
+    taken = Decision_TakeActions(actions, ACTION_QUEUE_SIZE);
+    assert(taken == ACTION_QUEUE_SIZE && actions[0].desire == 4 && actions[ACTION_QUEUE_SIZE-1].desire == ACTION_QUEUE_SIZE + 3,
+           "The newest decisions should have been kept in order");
+    while(Decision_TakeFeedback(&actions[0]));
+    EXECUTION_MODE = EXECUTION_MODE_INITIAL;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    puts("<<MSC Deferred execution test successful");
+}
+
+typedef struct
+{
+    int calls;
+    double desire;
+} OperationContext;
+
+static void MSC_OperationContext_Op(void *user, double desire)
+{
+    OperationContext *context = user;
+    context->calls++;
+    context->desire = desire;
+}
+
+static void MSC_OperationContext_Batch(void *user, Decision *decisions, int amount)
+{
+    OperationContext *context = user;
+    for(int i = 0; i < amount; i++)
+    {
+        assert(decisions[i].operationID == 1, "Batch should contain the op");
+        context->calls++;
+    }
+}
+
+void MSC_OperationContext_Test(void)
+{
+    MSC_INIT();
+    MOTOR_BABBLING_CHANCE = 0;
+    puts(">>MSC Operation context test start");
+    OperationContext context = {0};
+    OperationContext batch = {0};
+    MSC_AddOperationWithContext(Encode_Term("op"), MSC_OperationContext_Op, &context);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputBelief(Encode_Term("op"), 1);
+    MSC_AddInputBelief(Encode_Term("result"), 0);
+    MSC_Cycles(10);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("result"));
+    assert(context.calls == 1, "Op should have been called with its context");
+    assert(context.desire > DECISION_THRESHOLD, "Op should have received the decision's desire");
+    MSC_Cycles(10);
+    EXECUTION_MODE = EXECUTION_DEFERRED;
+    Decision_SetBatchDispatcher(MSC_OperationContext_Batch, &batch);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("result"));
+    assert(batch.calls == 1 && context.calls == 1, "Batch dispatcher should have received the decision instead of the op");
+    //a step with more decisions than ACTION_QUEUE_SIZE still hands all of them over at its end
+    batch.calls = 0;
+    long dropped = decision_actions_dropped;
+    for(int i = 0; i < ACTION_QUEUE_SIZE * 3; i++)
+    {
+        Decision decision = { .execute = true, .operationID = 1, .desire = 1.0 };
+        Decision_Execute(&decision);
+    }
+    Decision_DispatchActions();
+    assert(batch.calls == ACTION_QUEUE_SIZE * 3 && decision_actions_dropped == dropped && !Decision_ActionsPending(),
+           "Batch dispatcher should have received all decisions of the step");
+    Decision feedback;
+    while(Decision_TakeFeedback(&feedback));
+    EXECUTION_MODE = EXECUTION_MODE_INITIAL;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    puts("<<MSC Operation context test successful");
+}
+
 static bool MSC_Follow_Test_Left_executed = false;
 static bool MSC_Follow_Test_Right_executed = false;
 
@@ -577,6 +903,18 @@ void MSC_SequenceLen3_Test(void)
 
 static int exp1_last_operation = 0;
 
+static const TrialLog_Column exp1_columns[] = {
+    {TRIALLOG_STRING, "phase"}, {TRIALLOG_INT, "block"}, {TRIALLOG_INT, "trial"}, {TRIALLOG_INT, "a1_left"},
+    {TRIALLOG_INT, "chosen_op"}, {TRIALLOG_INT, "correct"}, {TRIALLOG_DOUBLE, "exp_a1_left"}, {TRIALLOG_DOUBLE, "exp_a1_right"},
+    {TRIALLOG_DOUBLE, "exp_a2_left"}, {TRIALLOG_DOUBLE, "exp_a2_right"} };
+static const TrialLog_Column exp3_columns[] = {
+    {TRIALLOG_STRING, "phase"}, {TRIALLOG_INT, "block"}, {TRIALLOG_INT, "trial"}, {TRIALLOG_INT, "sample"},
+    {TRIALLOG_INT, "left"}, {TRIALLOG_INT, "right"}, {TRIALLOG_INT, "chosen_op"}, {TRIALLOG_INT, "correct"},
+    {TRIALLOG_DOUBLE, "exp_a1_b1_left"}, {TRIALLOG_DOUBLE, "exp_a1_b1_right"}, {TRIALLOG_DOUBLE, "exp_a2_b2_left"},
+    {TRIALLOG_DOUBLE, "exp_a2_b2_right"} };
+//the log of an export, whose column buffers are too large for the stack
+static TrialLog exp_log;
+
 static void Exp1_OpLeft(void)
 {
     exp1_last_operation = 1;
@@ -587,7 +925,7 @@ static void Exp1_OpRight(void)
     exp1_last_operation = 2;
 }
 
-static void Exp1_LogTrial(FILE *log,
+static void Exp1_LogTrial(TrialLog *log,
                           const char *phase,
                           int block,
                           int trial,
@@ -609,18 +947,16 @@ static void Exp1_LogTrial(FILE *log,
     double exp_a1_right = Exp_BestExpectationFor(goalConcept, EXP1_OP_RIGHT_ID, &termA1_right);
     double exp_a2_left = Exp_BestExpectationFor(goalConcept, EXP1_OP_LEFT_ID, &termA2_left);
     double exp_a2_right = Exp_BestExpectationFor(goalConcept, EXP1_OP_RIGHT_ID, &termA2_right);
-    fprintf(log,
-            "%s,%d,%d,%d,%d,%d,%.6f,%.6f,%.6f,%.6f\n",
-            phase,
-            block + 1,
-            trial + 1,
-            a1_on_left ? 1 : 0,
-            chosen_operation,
-            success ? 1 : 0,
-            exp_a1_left,
-            exp_a1_right,
-            exp_a2_left,
-            exp_a2_right);
+    TrialLog_String(log, phase);
+    TrialLog_Int(log, block + 1);
+    TrialLog_Int(log, trial + 1);
+    TrialLog_Int(log, a1_on_left ? 1 : 0);
+    TrialLog_Int(log, chosen_operation);
+    TrialLog_Int(log, success ? 1 : 0);
+    TrialLog_Double(log, exp_a1_left);
+    TrialLog_Double(log, exp_a1_right);
+    TrialLog_Double(log, exp_a2_left);
+    TrialLog_Double(log, exp_a2_right);
 }
 
 static bool Exp_RunTrial(bool a1_on_left,
@@ -636,7 +972,7 @@ static bool Exp_RunTrial(bool a1_on_left,
                          const char *phase,
                          int block,
                          int trial,
-                         FILE *log)
+                         TrialLog *log)
 {
     if(a1_on_left)
     {
@@ -692,7 +1028,7 @@ static bool Exp_RunTrial(bool a1_on_left,
 
     MSC_Cycles(4);
     // Inter-trial interval of 100 time steps, mirroring the paper design.
-    MSC_Cycles(100);
+    MSC_AdvanceTime(100);
 
     Exp1_LogTrial(log,
                   phase,
@@ -721,7 +1057,7 @@ static int Exp_RunPhase(int blocks,
                         Term termOpRight,
                         Term termG,
                         const char *phase,
-                        FILE *log,
+                        TrialLog *log,
                         int *last_block_correct)
 {
     int correct = 0;
@@ -891,15 +1227,14 @@ void MSC_Exp1_TrainingOnly(void)
     puts("<<MSC Experiment 1 (training only) end");
 }
 
-void MSC_Exp1_ExportCSV(const char *path)
+static void Exp1_Export(const char *path, bool binary)
 {
-    FILE *csv = fopen(path, "w");
-    if(!csv)
+    TrialLog *log = &exp_log;
+    if(!TrialLog_Open(log, path, exp1_columns, sizeof(exp1_columns) / sizeof(exp1_columns[0]), binary))
     {
-        perror("Failed to open CSV output");
+        perror("Failed to open the trial log");
         return;
     }
-    fprintf(csv, "phase,block,trial,a1_left,chosen_op,correct,exp_a1_left,exp_a1_right,exp_a2_left,exp_a2_right\n");
 
     double original_babbling = MOTOR_BABBLING_CHANCE;
     MOTOR_BABBLING_CHANCE = 0.2;
@@ -932,7 +1267,7 @@ void MSC_Exp1_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "baseline",
-                 csv,
+                 log,
                  &dummy_last_block);
 
     Exp_RunPhase(EXP1_TRAINING_BLOCKS,
@@ -946,7 +1281,7 @@ void MSC_Exp1_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "training",
-                 csv,
+                 log,
                  &dummy_last_block);
 
     Exp_RunPhase(EXP1_TESTING_BLOCKS,
@@ -960,23 +1295,37 @@ void MSC_Exp1_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "testing",
-                 csv,
+                 log,
                  &dummy_last_block);
 
-    fclose(csv);
+    bool written = TrialLog_Close(log);
     MOTOR_BABBLING_CHANCE = original_babbling;
-    printf("Experiment 1 CSV written to %s\n", path);
+    if(!written)
+    {
+        fprintf(stderr, "Failed to write the trial log %s\n", path);
+        return;
+    }
+    printf("Experiment 1 %s written to %s\n", binary ? "log" : "CSV", path);
 }
 
-void MSC_Exp2_ExportCSV(const char *path)
+void MSC_Exp1_ExportCSV(const char *path)
+{
+    Exp1_Export(path, false);
+}
+
+void MSC_Exp1_ExportLog(const char *path)
+{
+    Exp1_Export(path, true);
+}
+
+static void Exp2_Export(const char *path, bool binary)
 {
-    FILE *csv = fopen(path, "w");
-    if(!csv)
+    TrialLog *log = &exp_log;
+    if(!TrialLog_Open(log, path, exp1_columns, sizeof(exp1_columns) / sizeof(exp1_columns[0]), binary))
     {
-        perror("Failed to open CSV output");
+        perror("Failed to open the trial log");
         return;
     }
-    fprintf(csv, "phase,block,trial,a1_left,chosen_op,correct,exp_a1_left,exp_a1_right,exp_a2_left,exp_a2_right\n");
 
     double original_babbling = MOTOR_BABBLING_CHANCE;
     MOTOR_BABBLING_CHANCE = 0.2;
@@ -1009,7 +1358,7 @@ void MSC_Exp2_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "baseline",
-                 csv,
+                 log,
                  &dummy_last_block);
 
     Exp_RunPhase(EXP2_TRAINING1_BLOCKS,
@@ -1023,7 +1372,7 @@ void MSC_Exp2_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "training1",
-                 csv,
+                 log,
                  &dummy_last_block);
 
     Exp_RunPhase(EXP2_TESTING1_BLOCKS,
@@ -1037,7 +1386,7 @@ void MSC_Exp2_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "testing1",
-                 csv,
+                 log,
                  &dummy_last_block);
 
     Exp_RunPhase(EXP2_TRAINING2_BLOCKS,
@@ -1051,7 +1400,7 @@ void MSC_Exp2_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "training2",
-                 csv,
+                 log,
                  &dummy_last_block);
 
     Exp_RunPhase(EXP2_TESTING2_BLOCKS,
@@ -1065,12 +1414,27 @@ void MSC_Exp2_ExportCSV(const char *path)
                  opRight,
                  termG,
                  "testing2",
-                 csv,
+                 log,
                  &dummy_last_block);
 
-    fclose(csv);
+    bool written = TrialLog_Close(log);
     MOTOR_BABBLING_CHANCE = original_babbling;
-    printf("Experiment 2 CSV written to %s\n", path);
+    if(!written)
+    {
+        fprintf(stderr, "Failed to write the trial log %s\n", path);
+        return;
+    }
+    printf("Experiment 2 %s written to %s\n", binary ? "log" : "CSV", path);
+}
+
+void MSC_Exp2_ExportCSV(const char *path)
+{
+    Exp2_Export(path, false);
+}
+
+void MSC_Exp2_ExportLog(const char *path)
+{
+    Exp2_Export(path, true);
 }
 
 static int exp3_last_operation = 0;
@@ -1085,7 +1449,7 @@ static void Exp3_OpRight(void)
     exp3_last_operation = EXP1_OP_RIGHT_ID;
 }
 
-static void Exp3_LogTrial(FILE *log,
+static void Exp3_LogTrial(TrialLog *log,
                           const char *phase,
                           int block,
                           int trial,
@@ -1120,20 +1484,18 @@ static void Exp3_LogTrial(FILE *log,
     int left_id = b1_on_left ? 1 : 2;
     int right_id = b1_on_left ? 2 : 1;
 
-    fprintf(log,
-            "%s,%d,%d,%d,%d,%d,%d,%d,%.6f,%.6f,%.6f,%.6f\n",
-            phase,
-            block + 1,
-            trial + 1,
-            sample_is_a1 ? 1 : 2,
-            left_id,
-            right_id,
-            chosen_operation,
-            success ? 1 : 0,
-            exp_a1_b1_left,
-            exp_a1_b1_right,
-            exp_a2_b2_left,
-            exp_a2_b2_right);
+    TrialLog_String(log, phase);
+    TrialLog_Int(log, block + 1);
+    TrialLog_Int(log, trial + 1);
+    TrialLog_Int(log, sample_is_a1 ? 1 : 2);
+    TrialLog_Int(log, left_id);
+    TrialLog_Int(log, right_id);
+    TrialLog_Int(log, chosen_operation);
+    TrialLog_Int(log, success ? 1 : 0);
+    TrialLog_Double(log, exp_a1_b1_left);
+    TrialLog_Double(log, exp_a1_b1_right);
+    TrialLog_Double(log, exp_a2_b2_left);
+    TrialLog_Double(log, exp_a2_b2_right);
 }
 
 static bool Exp3_RunTrial(bool sample_is_a1,
@@ -1151,7 +1513,7 @@ static bool Exp3_RunTrial(bool sample_is_a1,
                           const char *phase,
                           int block,
                           int trial,
-                          FILE *log)
+                          TrialLog *log)
 {
     Term sampleTerm = sample_is_a1 ? termSampleA1 : termSampleA2;
     Term leftTerm = b1_on_left ? termB1_left : termB2_left;
@@ -1208,7 +1570,7 @@ static bool Exp3_RunTrial(bool sample_is_a1,
     }
 
     MSC_Cycles(4);
-    MSC_Cycles(100);
+    MSC_AdvanceTime(100);
 
     Exp3_LogTrial(log,
                   phase,
@@ -1240,7 +1602,7 @@ static int Exp3_RunPhase(int blocks,
                          Term termOpRight,
                          Term termG,
                          const char *phase,
-                         FILE *log,
+                         TrialLog *log,
                          int *last_block_correct)
 {
     int correct = 0;
@@ -1363,15 +1725,14 @@ void MSC_Exp3_Test(void)
     puts("<<MSC Experiment 3 test successful");
 }
 
-void MSC_Exp3_ExportCSV(const char *path)
+static void Exp3_Export(const char *path, bool binary)
 {
-    FILE *csv = fopen(path, "w");
-    if(!csv)
+    TrialLog *log = &exp_log;
+    if(!TrialLog_Open(log, path, exp3_columns, sizeof(exp3_columns) / sizeof(exp3_columns[0]), binary))
     {
-        perror("Failed to open CSV output");
+        perror("Failed to open the trial log");
         return;
     }
-    fprintf(csv, "phase,block,trial,sample,left,right,chosen_op,correct,exp_a1_b1_left,exp_a1_b1_right,exp_a2_b2_left,exp_a2_b2_right\n");
 
     double original_babbling = MOTOR_BABBLING_CHANCE;
     MOTOR_BABBLING_CHANCE = 0.2;
@@ -1407,7 +1768,7 @@ void MSC_Exp3_ExportCSV(const char *path)
                   termOpRight,
                   termG,
                   "baseline",
-                  csv,
+                  log,
                   &dummy_last_block);
 
     Exp3_RunPhase(EXP3_TRAINING_BLOCKS,
@@ -1422,7 +1783,7 @@ void MSC_Exp3_ExportCSV(const char *path)
                   termOpRight,
                   termG,
                   "training",
-                  csv,
+                  log,
                   &dummy_last_block);
 
     Exp3_RunPhase(EXP3_TESTING_BLOCKS,
@@ -1437,10 +1798,983 @@ void MSC_Exp3_ExportCSV(const char *path)
                   termOpRight,
                   termG,
                   "testing",
-                  csv,
+                  log,
                   &dummy_last_block);
 
-    fclose(csv);
+    bool written = TrialLog_Close(log);
     MOTOR_BABBLING_CHANCE = original_babbling;
-    printf("Experiment 3 CSV written to %s\n", path);
+    if(!written)
+    {
+        fprintf(stderr, "Failed to write the trial log %s\n", path);
+        return;
+    }
+    printf("Experiment 3 %s written to %s\n", binary ? "log" : "CSV", path);
+}
+
+void MSC_Exp3_ExportCSV(const char *path)
+{
+    Exp3_Export(path, false);
+}
+
+void MSC_Exp3_ExportLog(const char *path)
+{
+    Exp3_Export(path, true);
+}
+
+void MSC_PropagationBudget_Test(void)
+{
+    MSC_INIT();
+    MOTOR_BABBLING_CHANCE = 0;
+    puts(">>MSC Propagation budget test start");
+    MSC_AddOperation(Encode_Term("op"), MSC_Procedure_Test_Op);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputBelief(Encode_Term("op"), 1);
+    MSC_AddInputBelief(Encode_Term("result"), 0);
+    MSC_Cycles(10);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("result"));
+    printf("iterations used: %d\n", propagation_iterations_used);
+    assert(propagation_iterations_used < PROPAGATION_ITERATIONS, "A shallow goal should converge before the iteration limit");
+    MSC_Cycles(10);
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoalWithBudget(Encode_Term("result"), 1);
+    assert(propagation_iterations_used == 1, "The goal should have been limited to its budget");
+    assert(PROPAGATION_ITERATIONS == PROPAGATION_ITERATIONS_INITIAL, "The global budget should have been restored");
+    MSC_Cycles(10);
+    PROPAGATION_UNTIL_CONVERGENCE = false;
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("result"));
+    assert(propagation_iterations_used == PROPAGATION_ITERATIONS, "Without convergence checks all iterations should be used");
+    PROPAGATION_UNTIL_CONVERGENCE = PROPAGATION_UNTIL_CONVERGENCE_INITIAL;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    puts("<<MSC Propagation budget test successful");
+}
+
+void MSC_BestFirstPlanning_Test(void)
+{
+    puts(">>MSC Best-first planning test start");
+    BEST_FIRST_PLANNING = true;
+    MSC_Multistep_Test();
+    MSC_Multistep2_Test();
+    assert(planner_expansions_used > 0, "The planner should have expanded the goal");
+    BEST_FIRST_PLANNING = BEST_FIRST_PLANNING_INITIAL;
+    puts("<<MSC Best-first planning test successful");
+}
+
+void MSC_PlanCache_Test(void)
+{
+    MSC_INIT();
+    OUTPUT = 0;
+    MOTOR_BABBLING_CHANCE = 0;
+    BEST_FIRST_PLANNING = true;
+    puts(">>MSC Plan cache test start");
+    MSC_AddOperation(Encode_Term("op"), MSC_Procedure_Test_Op);
+    for(int i = 0; i < 5; i++)
+    {
+        MSC_AddInputBelief(Encode_Term("a"), 0);
+        MSC_AddInputBelief(Encode_Term("op"), 1);
+        MSC_AddInputBelief(Encode_Term("b"), 0);
+        MSC_AddInputBelief(Encode_Term("c"), 0);
+        MSC_Cycles(10);
+    }
+    MSC_Cycles(10);
+    long hits = plan_cache_hits;
+    long misses = plan_cache_misses;
+    MSC_AddInputGoal(Encode_Term("c"));
+    int expansions = planner_expansions_used;
+    assert(plan_cache_misses == misses + 1, "The first goal has to be planned");
+    MSC_AddInputGoal(Encode_Term("c"));
+    assert(plan_cache_hits == hits + 1 && planner_expansions_used == expansions, "The repeated goal should reuse the plan");
+    //revising <b =/> c> changes a table the plan was derived from
+    MSC_AddInputBelief(Encode_Term("b"), 0);
+    MSC_AddInputBelief(Encode_Term("c"), 0);
+    MSC_AddInputGoal(Encode_Term("c"));
+    assert(plan_cache_misses == misses + 2, "Revising an implication of the plan should have invalidated it");
+    MSC_Procedure_Test_Op_executed = false;
+    MSC_AddInputBelief(Encode_Term("a"), 0);
+    MSC_AddInputGoal(Encode_Term("c"));
+    assert(MSC_Procedure_Test_Op_executed, "MSC should have executed op to reach c via b");
+    BEST_FIRST_PLANNING = BEST_FIRST_PLANNING_INITIAL;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    puts("<<MSC Plan cache test successful");
+}
+
+void MSC_MiningHorizon_Test(void)
+{
+    MSC_INIT();
+    OUTPUT = 0;
+    puts(">>MSC Mining horizon test start");
+    MINING_HORIZON = 5;
+    Term a = Encode_Term("a");
+    Term b = Encode_Term("b");
+    Term c = Encode_Term("c");
+    MSC_AddInputBelief(a, 0);
+    MSC_Cycles(10);
+    MSC_AddInputBelief(c, 0);
+    MSC_Cycles(2);
+    MSC_AddInputBelief(b, 0);
+    Concept *B = Test_ConceptOf(b);
+    assert(Exp_BestExpectationFor(B, 0, &c) > 0.0, "<c =/> b> is within the horizon");
+    assert(Exp_BestExpectationFor(B, 0, &a) == 0.0, "<a =/> b> is beyond the horizon");
+    MINING_HORIZON = MINING_HORIZON_INITIAL;
+    //an operation is related to every older entry, or only to those right before it
+    for(int adjacent=0; adjacent<2; adjacent++)
+    {
+        MSC_INIT();
+        MINING_ADJACENT_OPERATIONS = adjacent;
+        MSC_AddInputBelief(a, 0);
+        MSC_AddInputBelief(c, 0);
+        MSC_AddInputBelief(Encode_Term("^op"), 1);
+        MSC_AddInputBelief(b, 0);
+        B = Test_ConceptOf(b);
+        assert(Exp_BestExpectationFor(B, 1, &c) > 0.0, "<(&/,c,^op) =/> b> should have been formed");
+        assert((Exp_BestExpectationFor(B, 1, &a) > 0.0) == !adjacent, "<(&/,a,^op) =/> b> should only be formed with the older entries");
+    }
+    MINING_ADJACENT_OPERATIONS = MINING_ADJACENT_OPERATIONS_INITIAL;
+    puts("<<MSC Mining horizon test successful");
+}
+
+static void Test_Idle(bool advance, int cycles)
+{
+    if(advance)
+    {
+        MSC_AdvanceTime(cycles);
+    }
+    else
+    {
+        MSC_Cycles(cycles);
+    }
+}
+
+//idle intervals after some inputs, stepped or advanced, returning the final time along with the concept order, when the queued input occurred
+//and the time of the graph exported once in between
+static long Test_AdvanceTimeRun(bool advance, Item *order, long *pushedTime, long *exportedTime)
+{
+    const char *path = "msc_advance_time_test.dot";
+    remove(path);
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_SetInputLogging(false);
+    MSC_ExportGraphEvery(path, GRAPH_DOT, 550);
+    char *names[] = { "a", "b", "c", "d", "e" };
+    for(int i=0; i<5; i++)
+    {
+        MSC_AddInputBelief(Encode_Term(names[i]), 0);
+        Test_Idle(advance, 100);
+    }
+    //an input queued for the middle of the interval is added at its time
+    MSC_PushInput(Encode_Term("f"), EVENT_TYPE_BELIEF, MSC_DEFAULT_TRUTH, 0, currentTime + 37);
+    Test_Idle(advance, 100);
+    *pushedTime = FIFO_GetNewestSequence(&belief_events, 0)->occurrenceTime;
+    memcpy(order, concepts.items, concepts.itemsAmount * sizeof(Item));
+    MSC_ExportGraphEvery("", GRAPH_DOT, 0);
+    Graph_Wait();
+    *exportedTime = -1;
+    FILE *file = fopen(path, "r");
+    if(file != NULL)
+    {
+        assert(fscanf(file, "digraph msc {\n    label=\"time=%ld\"", exportedTime) == 1, "The export should be labeled with its time");
+        fclose(file);
+    }
+    remove(path);
+    MSC_SetInputLogging(true);
+    return currentTime;
+}
+
+void MSC_AdvanceTime_Test(void)
+{
+    puts(">>MSC AdvanceTime test start");
+    static Item stepped[CONCEPTS_MAX], advanced[CONCEPTS_MAX];
+    long steppedPushed, advancedPushed, steppedExported, advancedExported;
+    long steppedTime = Test_AdvanceTimeRun(false, stepped, &steppedPushed, &steppedExported);
+    long advancedTime = Test_AdvanceTimeRun(true, advanced, &advancedPushed, &advancedExported);
+    assert(advancedTime == steppedTime, "Advancing should take as long as stepping");
+    assert(advancedPushed == steppedPushed, "The queued input should be added at the same time");
+    assert(steppedExported == 550 && advancedExported == steppedExported, "The periodic export should happen within the skipped time too");
+    assert(memcmp(stepped, advanced, concepts.itemsAmount * sizeof(Item)) == 0, "The concepts should end up in the same order");
+    puts("<<MSC AdvanceTime test successful");
+}
+
+void MSC_DirtyTracking_Test(void)
+{
+    MSC_INIT();
+    OUTPUT = 0;
+    puts(">>MSC Dirty tracking test start");
+    Term a = Encode_Term("a");
+    Term g = Encode_Term("g");
+    MSC_AddInputBelief(a, 0);
+    MSC_AddInputBelief(g, 0);
+    //beliefs leave no goal spike to remove
+    assert(cycle_work_skipped == concepts.itemsAmount, "The spike removal should have been skipped for all concepts");
+    MSC_AddInputBelief(Encode_Term("x"), 0);
+    //the goal spike of g is propagated through <a =/> g>, x doesn't get one
+    MSC_AddInputGoal(g);
+    assert(cycle_work_skipped > 0 && cycle_work_skipped < concepts.itemsAmount - 1, "Only g and the concepts its spike was propagated to should have been reset");
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        assert(c->goal_spike.type == EVENT_TYPE_DELETED && c->incoming_goal_spike.type == EVENT_TYPE_DELETED, "All spikes should have been removed");
+    }
+    //without new concepts the order is kept
+    REBUILD_ON_CHANGE = true;
+    MSC_Cycles(1);
+    static Item order[CONCEPTS_MAX];
+    memcpy(order, concepts.items, concepts.itemsAmount * sizeof(Item));
+    MSC_Cycles(1);
+    assert(cycle_work_skipped == 2 * concepts.itemsAmount, "The idle cycle should have skipped both passes");
+    assert(memcmp(order, concepts.items, concepts.itemsAmount * sizeof(Item)) == 0, "The order should have been kept");
+    MSC_AddInputBelief(Encode_Term("b"), 0);
+    assert(cycle_work_skipped == concepts.itemsAmount, "The new concept should have been sorted in");
+    //a cycle ending early for the feedback of an operation skipped nothing
+    MSC_AddInputBelief(Encode_Term("^left"), 1);
+    assert(cycle_work_skipped == 0, "The count of the previous cycle shouldn't remain");
+    //the skipped concepts are counted in the stats while profiling
+    PROFILING = true;
+    MSC_ResetStats();
+    long skipped = 0;
+    for(int i=0; i<2; i++)
+    {
+        MSC_Cycles(1);
+        skipped += cycle_work_skipped;
+    }
+    Profile_Stats stats;
+    MSC_GetStats(&stats);
+    assert(stats.cycles == 2 && stats.conceptsSkipped == skipped && skipped > 0, "The stats should count the skipped concepts");
+    PROFILING = PROFILING_INITIAL;
+    REBUILD_ON_CHANGE = REBUILD_ON_CHANGE_INITIAL;
+    puts("<<MSC Dirty tracking test successful");
+}
+
+static int snapshot_operation = 0;
+
+static void Snapshot_OpLeft(void)
+{
+    snapshot_operation = 1;
+}
+
+static void Snapshot_OpRight(void)
+{
+    snapshot_operation = 2;
+}
+
+//a ball following task, returning a hash of the operations chosen
+static unsigned long Test_SnapshotTask(int steps)
+{
+    unsigned long trace = 0;
+    for(int i=0; i<steps; i++)
+    {
+        int ball = 1 + rand() % 2;
+        snapshot_operation = 0;
+        MSC_AddInputBelief(Encode_Term(ball == 1 ? "snapshot_left" : "snapshot_right"), 0);
+        MSC_AddInputGoal(Encode_Term("snapshot_good"));
+        if(snapshot_operation == ball)
+        {
+            MSC_AddInputBelief(Encode_Term("snapshot_good"), 0);
+        }
+        trace = trace * 31 + snapshot_operation;
+        MSC_Cycles(5);
+    }
+    return trace;
+}
+
+//the truth and evidence of all implications, in the order of the concepts
+static double Test_MemoryChecksum(void)
+{
+    double checksum = 0.0;
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi=0; opi<OPERATIONS_MAX; opi++)
+        {
+            for(int j=0; j<c->precondition_beliefs[opi].itemsAmount; j++)
+            {
+                Implication *imp = &c->precondition_beliefs[opi].array[j];
+                checksum += (i+1) * (j+1) * (imp->truth.frequency + 3 * imp->truth.confidence + imp->stamp.evidentalBase[0]);
+            }
+        }
+    }
+    return checksum;
+}
+
+void MSC_Snapshot_Test(void)
+{
+    const char *path = "msc_snapshot_test.bin";
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_SetInputLogging(false);
+    puts(">>MSC Snapshot test start");
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    srand(42);
+    Test_SnapshotTask(20);
+    assert(MSC_Save(path), "The snapshot should have been written");
+    srand(43);
+    unsigned long expected = Test_SnapshotTask(200);
+    double expectedChecksum = Test_MemoryChecksum();
+    long expectedTime = currentTime;
+    int expectedConcepts = concepts.itemsAmount;
+    int expectedStamp = stampID;
+    //the callbacks are found by name, not by where they were registered
+    MSC_INIT();
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    assert(MSC_Load(path), "The snapshot should have been loaded");
+    srand(43);
+    assert(Test_SnapshotTask(200) == expected, "The loaded state should continue exactly as the saved one");
+    assert(currentTime == expectedTime && concepts.itemsAmount == expectedConcepts && stampID == expectedStamp, "The loaded state should end the same");
+    assert(Test_MemoryChecksum() == expectedChecksum, "The loaded state should have learned the same");
+    //a truncated image is read completely before anything is replaced, also the dictionary of a previous load
+    assert(MSC_Save(path) && MSC_Load(path) && MSC_Load(path), "The snapshot should have been loaded twice");
+    static char image[1 << 22];
+    FILE *file = fopen(path, "rb");
+    size_t size = fread(image, 1, sizeof(image), file);
+    fclose(file);
+    char firstName[TERMS_LEN+1];
+    strcpy(firstName, terms[0]);
+    int encoded = term_index;
+    for(size_t cut = 64; cut < size; cut = cut * 3 / 2)
+    {
+        file = fopen(path, "wb");
+        fwrite(image, 1, cut, file);
+        fclose(file);
+        assert(!MSC_Load(path), "A truncated snapshot should be rejected");
+        assert(currentTime == expectedTime && Test_MemoryChecksum() == expectedChecksum && concepts.itemsAmount == expectedConcepts &&
+               term_index == encoded && !strcmp(terms[0], firstName), "A truncated snapshot should leave the state untouched");
+    }
+    //an image whose anticipations link out of the pool or in a cycle, or with a slot behind two items, is rejected
+    int link = anticipations.pool[0].next;
+    int links[] = { ANTICIPATIONS_MAX+1, -1, 1 };
+    for(int i=0; i<3; i++)
+    {
+        anticipations.pool[0].next = links[i];
+        assert(MSC_Save(path), "The snapshot should have been written");
+        anticipations.pool[0].next = link;
+        assert(!MSC_Load(path) && Test_MemoryChecksum() == expectedChecksum, "A snapshot with corrupt anticipations should be rejected");
+    }
+    void *address = concepts.items[1].address;
+    concepts.items[1].address = concepts.items[0].address;
+    assert(MSC_Save(path), "The snapshot should have been written");
+    concepts.items[1].address = address;
+    assert(!MSC_Load(path) && concepts.items[1].address == address, "A snapshot with a duplicate concept slot should be rejected");
+    //a file which is no snapshot is rejected without touching the state
+    file = fopen(path, "wb");
+    fputs("no snapshot", file);
+    fclose(file);
+    assert(!MSC_Load(path) && currentTime == expectedTime, "A foreign file should be rejected");
+    remove(path);
+    MSC_SetInputLogging(true);
+    puts("<<MSC Snapshot test successful");
+}
+
+//the truth and evidence of all implications, in the order of the storage slots
+static double Test_StoredChecksum(void)
+{
+    double checksum = 0.0;
+    for(int i=0; i<CONCEPTS_MAX; i++)
+    {
+        Concept *c = &concept_storage[i];
+        for(int opi=0; c->generation != 0 && opi<OPERATIONS_MAX; opi++)
+        {
+            for(int j=0; j<c->precondition_beliefs[opi].itemsAmount; j++)
+            {
+                Implication *imp = &c->precondition_beliefs[opi].array[j];
+                checksum += (i+1) * (j+1) * (imp->truth.frequency + 3 * imp->truth.confidence + imp->stamp.evidentalBase[0]);
+            }
+        }
+    }
+    return checksum;
+}
+
+//the priorities of the concept queue, by slot
+static double Test_QueueChecksum(void)
+{
+    double checksum = 0.0;
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        checksum += (Memory_ConceptSlot(concepts.items[i].address)+1) * concepts.items[i].priority;
+    }
+    return checksum;
+}
+
+void Memory_ConceptStore_Test(void)
+{
+    const char *path = "msc_concept_store_test.bin";
+    remove(path);
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_SetInputLogging(false);
+    puts(">>Concept store test start");
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    assert(MSC_MapConcepts(path), "The store should have been created");
+    srand(42);
+    ANTICIPATION_SCHEDULED = true;
+    Test_SnapshotTask(50);
+    ANTICIPATION_SCHEDULED = ANTICIPATION_SCHEDULED_INITIAL;
+    assert(Decision_AnticipationsPending(), "Anticipations should wait for the concepts of the store");
+    double expectedChecksum = Test_StoredChecksum();
+    int expectedConcepts = concepts.itemsAmount;
+    int expectedId = concept_id;
+    double expectedQueue = Test_QueueChecksum();
+    long expectedTime = currentTime;
+    Term left = Encode_Term("snapshot_left");
+    int index;
+    assert(Memory_FindConceptByTerm(&left, &index), "The concept should have been created");
+    Usage expectedUsage = ((Concept*) concepts.items[index].address)->usage;
+    assert(expectedChecksum != 0.0, "Implications should have been learned");
+    MSC_UnmapConcepts();
+    assert(concepts.itemsAmount == 0 && Test_StoredChecksum() == 0.0, "Unmapping should leave an empty memory");
+    assert(!Decision_AnticipationsPending(), "No anticipation should point into the unmapped concepts");
+    //a reset detaches the store instead of clearing it
+    MSC_INIT();
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    assert(MSC_MapConcepts(path), "The store should have been mapped to be reset");
+    MSC_INIT();
+    assert(concepts.itemsAmount == 0 && concept_storage != NULL && Test_StoredChecksum() == 0.0, "The reset should leave an empty memory");
+    //the terms are encoded in the same order as when they were stored
+    MSC_INIT();
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    assert(MSC_MapConcepts(path), "The store should have been mapped again");
+    assert(concepts.itemsAmount == expectedConcepts && concept_id == expectedId, "The concepts should have been kept");
+    assert(Test_StoredChecksum() == expectedChecksum, "The implications should have been kept");
+    assert(Test_QueueChecksum() == expectedQueue, "The concepts should have kept their priorities");
+    assert(currentTime == expectedTime, "The time should continue from the one the store was synced at");
+    assert(Memory_FindConceptByTerm(&left, &index), "The stored concepts should be found by term");
+    Usage usage = ((Concept*) concepts.items[index].address)->usage;
+    assert(usage.useCount == expectedUsage.useCount && usage.lastUsed == expectedUsage.lastUsed, "The concepts should have kept their usage");
+    //learning continues in the store
+    Test_SnapshotTask(50);
+    assert(Test_StoredChecksum() != expectedChecksum, "Learning should have continued in the store");
+    MSC_UnmapConcepts();
+    //a file which is no store of this layout is rejected
+    FILE *file = fopen(path, "wb");
+    fputs("no concept store", file);
+    fclose(file);
+    MSC_INIT();
+    assert(!MSC_MapConcepts(path) && concept_storage != NULL && concepts.itemsAmount == 0, "A foreign file should be rejected");
+    remove(path);
+    MSC_SetInputLogging(true);
+    puts("<<Concept store test successful");
+}
+
+void MSC_Journal_Test(void)
+{
+    const char *snapshotPath = "msc_journal_test.snap";
+    const char *journalPath = "msc_journal_test.jrnl";
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_SetInputLogging(false);
+    puts(">>MSC Journal test start");
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    srand(42);
+    Test_SnapshotTask(20);
+    assert(MSC_OpenJournal(snapshotPath, journalPath), "The base snapshot and journal should have been written");
+    long baseTime = currentTime;
+    Test_SnapshotTask(100);
+    //filling memory with sequences, evicting concepts and removing the implications formed from them
+    static char names[40][20];
+    for(int i=0; i<1500; i++)
+    {
+        int k = rand() % 40;
+        sprintf(names[k], "journal_%d", k);
+        MSC_AddInputBelief(Encode_Term(names[k]), 0);
+    }
+    assert(concepts.itemsAmount == CONCEPTS_MAX, "Memory should have been filled");
+    double expectedChecksum = Test_StoredChecksum();
+    int expectedConcepts = concepts.itemsAmount;
+    int expectedId = concept_id;
+    long expectedTime = currentTime;
+    assert(journal_records > 0, "The changes should have been journaled");
+    //the journal is flushed after each step, so stopping here is like a crash
+    MSC_INIT();
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    assert(MSC_Recover(snapshotPath, journalPath), "The journal should have been recovered");
+    assert(Test_StoredChecksum() == expectedChecksum, "The recovered implications should be the journaled ones");
+    assert(concepts.itemsAmount == expectedConcepts && concept_id == expectedId, "The recovered concepts should be the journaled ones");
+    assert(currentTime > baseTime && currentTime <= expectedTime, "The time should continue after the last change");
+    //compaction keeps the journal short, and recovery ends the same
+    JOURNAL_COMPACT_RECORDS = 100;
+    assert(MSC_OpenJournal(snapshotPath, journalPath), "The journal should have been reopened");
+    baseTime = currentTime;
+    Test_SnapshotTask(100);
+    expectedChecksum = Test_StoredChecksum();
+    assert(MSC_CloseJournal(), "The journal should have been written");
+    FILE *file = fopen(journalPath, "rb");
+    long journalBaseTime;
+    assert(Journal_ReadHeader(file, &journalBaseTime) && journalBaseTime > baseTime, "The journal should have been compacted");
+    fclose(file);
+    MSC_INIT();
+    assert(MSC_Recover(snapshotPath, journalPath), "The compacted journal should have been recovered");
+    assert(Test_StoredChecksum() == expectedChecksum, "The compacted journal should end the same");
+    //a record cut short ends the journal
+    static char journal[1 << 20];
+    file = fopen(journalPath, "rb");
+    size_t size = fread(journal, 1, sizeof(journal), file);
+    fclose(file);
+    file = fopen(journalPath, "wb");
+    fwrite(journal, 1, size - 1, file);
+    fclose(file);
+    MSC_INIT();
+    assert(MSC_Recover(snapshotPath, journalPath), "A journal cut short should have been recovered");
+    //loading another state ends the journal, which continues the previous memory
+    assert(MSC_OpenJournal(snapshotPath, journalPath) && MSC_Load(snapshotPath) && !Journal_Active(), "The load should have closed the journal");
+    //a failed compaction is retried after as many records again rather than at every cycle
+    const char *directory = "msc_journal_test.dir";
+    char unwritable[64];
+    sprintf(unwritable, "%s/base.snap", directory);
+    mkdir(directory, 0755);
+    assert(MSC_OpenJournal(unwritable, journalPath), "The journal should have been opened in the directory");
+    remove(unwritable);
+    rmdir(directory);
+    long failed = msc_checkpoints_failed;
+    Test_SnapshotTask(100);
+    assert(Journal_Active() && msc_checkpoints_failed > failed && msc_checkpoints_failed - failed <= journal_records / JOURNAL_COMPACT_RECORDS,
+           "The failed compactions should have been counted and backed off");
+    MSC_CloseJournal();
+    JOURNAL_COMPACT_RECORDS = JOURNAL_COMPACT_RECORDS_INITIAL;
+    remove(snapshotPath);
+    remove(journalPath);
+    MSC_SetInputLogging(true);
+    puts("<<MSC Journal test successful");
+}
+
+void MSC_Shell_Test(void)
+{
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_SetInputLogging(false);
+    MOTOR_BABBLING_CHANCE = 0;
+    puts(">>MSC Shell test start");
+    Shell_Command command;
+    char line[] = "  shell_x. :|: %0.5;0.8%  ";
+    assert(Shell_Parse(line, &command) && command.type == SHELL_BELIEF && !strcmp(command.name, "shell_x") &&
+           command.truth.frequency == 0.5 && command.truth.confidence == 0.8, "The belief should have been parsed");
+    char bad[] = "shell_x. %2;0.9%";
+    assert(!Shell_Parse(bad, &command), "A frequency above 1 should be rejected");
+    //the procedure test through the protocol
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    fputs("*op ^shell_op\n"
+          "shell_a.\n"
+          "^shell_op.\n"
+          "shell_result.\n"
+          "// the goal triggers the learned procedure\n"
+          "shell_a.\n"
+          "shell_result!\n"
+          "shell_result?\n"
+          "shell_unknown?\n"
+          "*time\n"
+          "3\n"
+          "*time\n"
+          "*concepts\n"
+          "*op shell_b\n"
+          "shell_a", in);
+    rewind(in);
+    long failed = Shell_Run(in, out);
+    static char answers[4096];
+    rewind(out);
+    answers[fread(answers, 1, sizeof(answers)-1, out)] = 0;
+    fclose(in);
+    fclose(out);
+    fputs(answers, stdout);
+    assert(failed == 2 && strstr(answers, "Error: line 14\nError: line 15\n"), "The operation without ^ and the line without punctuation should fail");
+    assert(strstr(answers, "^shell_op executed\n") != NULL, "The operation should have been executed");
+    assert(strstr(answers, "Answer: <(&/,shell_a,^shell_op,+") != NULL, "The procedure should have been answered");
+    assert(strstr(answers, "Answer: None.\n") != NULL, "The unknown term should have no answer");
+    char amount[32];
+    sprintf(amount, "concepts=%d\n", concepts.itemsAmount);
+    assert(strstr(answers, amount) != NULL, "The concepts should have been counted");
+    char *time = strstr(answers, "time=");
+    assert(time != NULL && strstr(time+1, "time=") != NULL && atol(strstr(time+1, "time=") + 5) == atol(time + 5) + 3, "The cycles should have been run");
+    //names which don't fit the dictionary fail their line instead of the process
+    int encoded = term_index;
+    in = tmpfile();
+    out = tmpfile();
+    fprintf(in, "*op ^%0*d\n", TERMS_LEN, 0);
+    for(int i=term_index; i<=TERMS_ENCODABLE; i++)
+    {
+        fprintf(in, "shell_name%d.\n", i);
+    }
+    rewind(in);
+    failed = Shell_Run(in, out);
+    static char errors[256];
+    rewind(out);
+    errors[fread(errors, 1, sizeof(errors)-1, out)] = 0;
+    fclose(in);
+    fclose(out);
+    char expected[64];
+    sprintf(expected, "Error: line 1\nError: line %d\n", TERMS_ENCODABLE - encoded + 2);
+    assert(failed == 2 && !strcmp(errors, expected) && term_index == TERMS_ENCODABLE, "The overlong operation and the name beyond the limit should fail");
+    //the names are forgotten again for the following tests
+    term_index = encoded;
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    MSC_SetInputLogging(true);
+    puts("<<MSC Shell test successful");
+}
+
+void MSC_Trace_Test(void)
+{
+    const char *path = "msc_trace_test.bin";
+    MSC_SetInputLogging(false);
+    puts(">>MSC Trace test start");
+    assert(Trace_Start(path), "The trace should have been started");
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    srand(42);
+    Test_SnapshotTask(100);
+    MSC_AdvanceTime(500);
+    Test_SnapshotTask(20);
+    assert(Trace_Stop(), "The trace should have been written");
+    long expectedTime = currentTime;
+    double expectedChecksum = Test_MemoryChecksum();
+    //the draws of the reasoner come from the trace
+    srand(7);
+    assert(MSC_Replay(path), "The replay should have made the recorded decisions");
+    long records = trace_position;
+    assert(currentTime == expectedTime && Test_MemoryChecksum() == expectedChecksum, "The replay should have learned the same");
+    //a changed decision rule is caught where it first decides differently
+    MOTOR_BABBLING_CHANCE = 0;
+    assert(!MSC_Replay(path) && trace_diverged, "The replay without babbling should have diverged");
+    assert(trace_position > 0 && trace_position < records, "The divergence should have been found within the trace");
+    printf("records=%ld diverged at=%ld\n", records, trace_position);
+    MOTOR_BABBLING_CHANCE = MOTOR_BABBLING_CHANCE_INITIAL;
+    assert(!MSC_Replay("msc_trace_test_missing.bin") && !trace_diverged, "A missing trace shouldn't be replayed");
+    //a trace whose magic, version or layout differs from the header of this build isn't replayed
+    static char trace[1 << 20];
+    FILE *file = fopen(path, "rb");
+    size_t size = fread(trace, 1, sizeof(trace), file);
+    fclose(file);
+    size_t fields[] = { 0, BINARY_MAGIC_LEN, BINARY_MAGIC_LEN + sizeof(int) };
+    for(int i=0; i<3; i++)
+    {
+        trace[fields[i]] ^= 1;
+        file = fopen(path, "wb");
+        fwrite(trace, 1, size, file);
+        fclose(file);
+        trace[fields[i]] ^= 1;
+        assert(!MSC_Replay(path) && !trace_diverged, "A trace with another header shouldn't be replayed");
+    }
+    remove(path);
+    MSC_SetInputLogging(true);
+    puts("<<MSC Trace test successful");
+}
+
+void TrialLog_Test(void)
+{
+    static TrialLog text, binary;
+    const char *textPath = "msc_trial_log_test.csv";
+    const char *binaryPath = "msc_trial_log_test.bin";
+    puts(">>TrialLog test start");
+    static const TrialLog_Column columns[] = { {TRIALLOG_STRING, "phase"}, {TRIALLOG_INT, "trial"}, {TRIALLOG_DOUBLE, "expectation"} };
+    assert(TrialLog_Open(&text, textPath, columns, 3, false) && TrialLog_Open(&binary, binaryPath, columns, 3, true), "The logs should have been opened");
+    //more rows than a block, with strings first used in later blocks
+    const char *phases[] = { "baseline", "training", "testing" };
+    int rows = 2 * TRIALLOG_BLOCK_ROWS + 7;
+    for(int i=0; i<rows; i++)
+    {
+        for(int j=0; j<2; j++)
+        {
+            TrialLog *log = j ? &binary : &text;
+            TrialLog_String(log, phases[i * 3 / rows]);
+            TrialLog_Int(log, i - 5);
+            TrialLog_Double(log, (i % 97) / 96.0 - 0.25);
+        }
+    }
+    assert(TrialLog_Close(&text) && TrialLog_Close(&binary), "The logs should have been written");
+    static char expected[1 << 17], converted[1 << 17];
+    FILE *file = fopen(textPath, "rb");
+    size_t length = fread(expected, 1, sizeof(expected), file);
+    fclose(file);
+    FILE *csv = tmpfile();
+    assert(TrialLog_ToCSV(binaryPath, csv), "The binary log should have been converted");
+    rewind(csv);
+    size_t convertedLength = fread(converted, 1, sizeof(converted), csv);
+    fclose(csv);
+    assert(length < sizeof(expected) && convertedLength == length && !memcmp(expected, converted, length), "The converted log should equal the CSV log");
+    //a block cut short isn't converted
+    file = fopen(binaryPath, "rb");
+    length = fread(converted, 1, sizeof(converted), file);
+    fclose(file);
+    file = fopen(binaryPath, "wb");
+    fwrite(converted, 1, length - 4, file);
+    fclose(file);
+    csv = tmpfile();
+    assert(!TrialLog_ToCSV(binaryPath, csv) && !TrialLog_ToCSV(textPath, csv), "A log cut short or a CSV log shouldn't be converted");
+    fclose(csv);
+    remove(textPath);
+    remove(binaryPath);
+    puts("<<TrialLog test successful");
+}
+
+void MSC_EventLog_Test(void)
+{
+    MSC_INIT();
+    OUTPUT = 0;
+    puts(">>MSC EventLog test start");
+    int levels[EVENTLOG_CATEGORIES];
+    for(int i=0; i<EVENTLOG_CATEGORIES; i++)
+    {
+        levels[i] = EVENTLOG_LEVEL[i];
+        EVENTLOG_LEVEL[i] = EVENTLOG_RING;
+    }
+    EventLog_RESET();
+    FILE *file = tmpfile();
+    assert(EventLog_StartDrainer(file, false) && !EventLog_StartDrainer(file, false), "One drainer should have been started");
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    srand(42);
+    Test_SnapshotTask(100);
+    EventLog_StopDrainer();
+    rewind(file);
+    int amounts[EVENTLOG_CATEGORIES] = {0};
+    long time = 0;
+    EventLog_Record record;
+    while(fread(&record, sizeof(record), 1, file) == 1)
+    {
+        assert(record.category >= 0 && record.category < EVENTLOG_CATEGORIES && record.time >= time, "The records should be in order");
+        assert(record.category != EVENTLOG_DECISION || record.expectation >= DECISION_THRESHOLD, "Decisions should be above the threshold");
+        time = record.time;
+        amounts[(int) record.category]++;
+    }
+    fclose(file);
+    printf("decisions=%d inputs=%d implications=%d anticipations=%d dropped=%lu\n", amounts[EVENTLOG_DECISION],
+           amounts[EVENTLOG_INPUT], amounts[EVENTLOG_IMPLICATION], amounts[EVENTLOG_ANTICIPATION], eventlog_dropped);
+    assert(amounts[EVENTLOG_DECISION] > 0 && amounts[EVENTLOG_IMPLICATION] > 0 && amounts[EVENTLOG_ANTICIPATION] > 0, "The reasoning should have been logged");
+    //the task adds a sensation and a goal per step, and the feedback of executed operations
+    assert(amounts[EVENTLOG_INPUT] >= 200 && eventlog_dropped == 0, "Each input should have been logged");
+    //a full ring drops the records which don't fit
+    EventLog_RESET();
+    EVENTLOG_LEVEL[EVENTLOG_IMPLICATION] = EVENTLOG_LEVEL[EVENTLOG_ANTICIPATION] = EVENTLOG_LEVEL[EVENTLOG_DECISION] = EVENTLOG_OFF;
+    for(int i=0; i<EVENTLOG_RING_SIZE + 10; i++)
+    {
+        MSC_AddInputBelief(Encode_Term("snapshot_left"), 0);
+    }
+    assert(eventlog_dropped == 10, "The records beyond the ring size should have been dropped");
+    int drained = 0;
+    while(EventLog_Take(&record))
+    {
+        drained++;
+    }
+    assert(drained == EVENTLOG_RING_SIZE, "The ring should have been drained");
+    //records are printed as text, and nothing is logged when off
+    static char line[256];
+    file = tmpfile();
+    EventLog_Print(&(EventLog_Record) { .category = EVENTLOG_INPUT, .type = EVENT_TYPE_GOAL, .time = 7, .term = Encode_Term("snapshot_good"),
+                                        .truth = MSC_DEFAULT_TRUTH }, file);
+    rewind(file);
+    assert(fgets(line, sizeof(line), file) != NULL && !strcmp(line, "7 input snapshot_good! :|: %1.000000;0.900000%\n"), "The record should have been printed");
+    fclose(file);
+    //drained text doesn't read the dictionary, which belongs to the reasoner thread
+    file = tmpfile();
+    time = currentTime;
+    MSC_AddInputBelief(Encode_Term("snapshot_left"), 0);
+    assert(EventLog_Drain(file, true) == 1, "The input should have been drained");
+    rewind(file);
+    static char expectedLine[256];
+    sprintf(expectedLine, "%ld input %d. :|: %%1.000000;0.900000%%\n", time, (unsigned char) Encode_Term("snapshot_left").terms[0]);
+    assert(fgets(line, sizeof(line), file) != NULL && !strcmp(line, expectedLine), "The drained record should name the term by its number");
+    fclose(file);
+    for(int i=0; i<EVENTLOG_CATEGORIES; i++)
+    {
+        EVENTLOG_LEVEL[i] = EVENTLOG_OFF;
+    }
+    Test_SnapshotTask(5);
+    assert(!EventLog_Take(&record), "Nothing should have been logged");
+    for(int i=0; i<EVENTLOG_CATEGORIES; i++)
+    {
+        EVENTLOG_LEVEL[i] = levels[i];
+    }
+    puts("<<MSC EventLog test successful");
+}
+
+//the amount of lines of the file, and whether one of them contains the text
+static int Test_FileLines(const char *path, const char *text, bool *found)
+{
+    static char line[1024];
+    int lines = 0;
+    *found = false;
+    FILE *file = fopen(path, "r");
+    while(file != NULL && fgets(line, sizeof(line), file) != NULL)
+    {
+        lines++;
+        *found = *found || strstr(line, text) != NULL;
+    }
+    if(file != NULL)
+    {
+        fclose(file);
+    }
+    return lines;
+}
+
+void MSC_Graph_Test(void)
+{
+    const char *dotPath = "msc_graph_test.dot";
+    const char *jsonPath = "msc_graph_test.jsonl";
+    MSC_INIT();
+    OUTPUT = 0;
+    MSC_SetInputLogging(false);
+    puts(">>MSC Graph test start");
+    assert(Graph_Format(dotPath) == GRAPH_DOT && Graph_Format(jsonPath) == GRAPH_JSON && Graph_Format("graph") == GRAPH_DOT, "The format should follow the extension");
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    srand(42);
+    Test_SnapshotTask(100);
+    int edges = 0;
+    for(int i=0; i<concepts.itemsAmount; i++)
+    {
+        Concept *c = concepts.items[i].address;
+        for(int opi=0; opi<OPERATIONS_MAX; opi++)
+        {
+            for(int j=0; j<c->precondition_beliefs[opi].itemsAmount; j++)
+            {
+                edges += Memory_ImplicationValid(&c->precondition_beliefs[opi].array[j]);
+            }
+        }
+    }
+    //the exports are of the memory when they were started, not of the reset one the writer finds
+    assert(MSC_ExportGraph(dotPath, GRAPH_DOT), "The DOT export should have been started");
+    MSC_INIT();
+    Test_SnapshotTask(3);
+    assert(Graph_Wait(), "The DOT export should have been written");
+    bool found;
+    int lines = Test_FileLines(dotPath, "\"snapshot_left\" -> \"snapshot_good\" [label=\"^snapshot_left +", &found);
+    assert(edges > 0 && lines == edges + 3 && found, "The DOT export should have an edge per valid implication");
+    MSC_INIT();
+    MSC_AddOperation(Encode_Term("^snapshot_left"), Snapshot_OpLeft);
+    MSC_AddOperation(Encode_Term("^snapshot_right"), Snapshot_OpRight);
+    srand(42);
+    Test_SnapshotTask(100);
+    assert(MSC_ExportGraph(jsonPath, GRAPH_JSON) && Graph_Wait(), "The JSON export should have been written");
+    lines = Test_FileLines(jsonPath, "\"precondition\":\"snapshot_left\",\"operation\":\"^snapshot_left\",\"postcondition\":\"snapshot_good\"", &found);
+    assert(lines == edges && found, "The JSON export should have a line per valid implication");
+    //the periodic export happens at a cycle boundary whose time is a multiple of the interval
+    remove(jsonPath);
+    MSC_ExportGraphEvery(jsonPath, GRAPH_JSON, 10);
+    Test_SnapshotTask(4);
+    MSC_ExportGraphEvery(jsonPath, GRAPH_JSON, 0);
+    assert(Graph_Wait(), "The periodic export should have been written");
+    FILE *file = fopen(jsonPath, "r");
+    long time = 0;
+    assert(file != NULL && fscanf(file, "{\"time\":%ld", &time) == 1 && time % 10 == 0 && time <= currentTime, "The periodic export should be of a cycle boundary");
+    fclose(file);
+    assert(!MSC_ExportGraph("msc_graph_test_missing/graph.dot", GRAPH_DOT) || !Graph_Wait(), "An export to a missing directory should fail");
+    remove(dotPath);
+    remove(jsonPath);
+    MSC_SetInputLogging(true);
+    puts("<<MSC Graph test successful");
+}
+
+void MSC_Workload_Test(void)
+{
+    puts(">>MSC Workload test start");
+    Workload_Config config = WORKLOAD_DEFAULT;
+    assert(Workload_Set(&config, "alphabet=8") && Workload_Set(&config, "contingencies=4") && Workload_Set(&config, "cycles=3000") &&
+           Workload_Set(&config, "noise=0"), "The settings should have been accepted");
+    assert(!Workload_Set(&config, "alphabet=0") && !Workload_Set(&config, "noise=2") && !Workload_Set(&config, "cycle=5") &&
+           !Workload_Set(&config, "seed") && !Workload_Set(&config, "goal_rate=x") && !Workload_Set(&config, "alphabet=1e30"),
+           "Invalid settings should have been refused");
+    assert(config.alphabet == 8 && config.noise == 0.0, "Refused settings should have left the configuration unchanged");
+    Workload_Stats first, second;
+    assert(Workload_Run(&config, &first) && Workload_Run(&config, &second), "The workload should have been run");
+    printf("cycles=%ld decisions=%ld successes=%ld concepts=%d\n", first.cycles, first.decisions, first.successes, first.concepts);
+    assert(first.cycles >= config.cycles && first.concepts > 0 && first.goals > 0 && first.decisions > 0, "The reasoner should have been driven");
+    assert(first.successes > 0 && first.successes <= first.decisions, "Some decisions should have met a contingency");
+    assert(first.latency50 <= first.latency90 && first.latency90 <= first.latency99 && first.latency99 <= first.latencyMax, "The latency percentiles should be ordered");
+    assert(first.decisions == second.decisions && first.successes == second.successes && first.conceptsCreated == second.conceptsCreated,
+           "The same seed should drive the reasoner the same");
+    config.contingencies = 9;
+    assert(!Workload_Run(&config, &first), "More contingencies than stimuli should have been refused");
+    puts("<<MSC Workload test successful");
+}
+
+void MSC_Stats_Test(void)
+{
+    puts(">>MSC Stats test start");
+    Workload_Config config = WORKLOAD_DEFAULT;
+    config.alphabet = 8;
+    config.contingencies = 4;
+    config.cycles = 3000;
+    config.noise = 0.0;
+    Workload_Stats plain, profiled;
+    Profile_Stats stats;
+    MSC_ResetStats();
+    assert(Workload_Run(&config, &plain), "The workload should have been run");
+    MSC_GetStats(&stats);
+    assert(stats.cycles == 0 && stats.pairsMined == 0 && stats.nanoseconds[PROFILE_EVENTS] == 0, "Nothing should have been counted without profiling");
+    PROFILING = true;
+    assert(Workload_Run(&config, &profiled), "The workload should have been run");
+    PROFILING = false;
+    MSC_GetStats(&stats);
+    printf("cycles=%ld pairs=%ld formed=%ld revised=%ld spikes=%ld decisions=%ld\n", stats.cycles, stats.pairsMined,
+           stats.implicationsFormed, stats.implicationsRevised, stats.spikesPropagated, stats.decisions);
+    assert(plain.decisions == profiled.decisions && plain.conceptsCreated == profiled.conceptsCreated, "Profiling shouldn't change the reasoning");
+    assert(stats.cycles == profiled.cycles && stats.decisions == profiled.decisions, "Each cycle and decision should have been counted");
+    assert(stats.implicationsRevised > 0 && stats.implicationsRevised <= stats.implicationsFormed && stats.implicationsFormed <= stats.pairsMined,
+           "Each revised implication should have been formed from a mined pair");
+    assert(stats.spikesPropagated > 0, "The goals should have propagated spikes");
+    long profiledNanoseconds = 0;
+    for(int i=0; i<PROFILE_PHASES; i++)
+    {
+        assert(stats.nanoseconds[i] >= 0, "A phase can't take negative time");
+        profiledNanoseconds += stats.nanoseconds[i];
+    }
+    //the cycles nested in an immediate execution pause its phase rather than being counted in both
+    assert(stats.decisions > 0 && profiledNanoseconds <= profiled.seconds * 1e9, "The phases can't take longer than the run");
+    assert(stats.nanoseconds[PROFILE_EVENTS] > 0 && stats.nanoseconds[PROFILE_MINING] > 0 && stats.nanoseconds[PROFILE_REBUILD] > 0,
+           "The phases which ran should have been timed");
+    MSC_ResetStats();
+    MSC_GetStats(&stats);
+    assert(stats.cycles == 0 && stats.decisions == 0, "The stats should have been reset");
+    puts("<<MSC Stats test successful");
+}
+
+void MSC_Perf_Test(void)
+{
+    puts(">>MSC Perf test start");
+    Perf_Counts start, counts;
+    bool available = Perf_Open();
+    assert(available || Perf_Error() != NULL, "The reason should be known if no counter could be opened");
+    bool counting = false;
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        counting = counting || Perf_Counting(i);
+    }
+    assert(counting == available, "The counters which opened should be counted");
+    Perf_Read(&start);
+    volatile long sum = 0;
+    for(long i=0; i<1000000; i++)
+    {
+        sum += i;
+    }
+    Perf_Since(&start, &counts);
+    for(int i=0; i<PERF_COUNTERS; i++)
+    {
+        assert(Perf_Counting(i) ? counts.values[i] >= 0 : counts.values[i] == PERF_UNAVAILABLE, "Only the counters being counted should have counts");
+    }
+    if(Perf_Counting(PERF_INSTRUCTIONS))
+    {
+        assert(counts.values[PERF_INSTRUCTIONS] >= 1000000, "The loop should have been counted");
+    }
+    //the phases are profiled the same with and without counters
+    MSC_ResetStats();
+    PROFILING = true;
+    MSC_INIT();
+    MSC_AddInputBelief(Encode_Term("perf_a"), 0);
+    MSC_AddInputBelief(Encode_Term("perf_b"), 0);
+    PROFILING = false;
+    Profile_Stats stats;
+    MSC_GetStats(&stats);
+    assert(stats.cycles == 2 && stats.counted == counting, "The phases should have been counted where counters are available");
+    Perf_Close();
+    assert(!Perf_Counting(PERF_CYCLES), "The counters should have been closed");
+    Perf_Read(&counts);
+    assert(counts.values[PERF_CYCLES] == PERF_UNAVAILABLE, "Closed counters should read as unavailable");
+    MSC_ResetStats();
+    puts("<<MSC Perf test successful");
 }